@@ -0,0 +1,45 @@
+#include "breezybenchallocations.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<quint64> s_count{0};
+    std::atomic<quint64> s_bytes{0};
+
+    void *countedAllocate(std::size_t size)
+    {
+        s_count.fetch_add(1, std::memory_order_relaxed);
+        s_bytes.fetch_add(size, std::memory_order_relaxed);
+        return std::malloc(size ? size : 1);
+    }
+}
+
+namespace BreezyBench
+{
+
+AllocationCounters allocations()
+{
+    return {s_count.load(std::memory_order_relaxed), s_bytes.load(std::memory_order_relaxed)};
+}
+
+} // namespace BreezyBench
+
+// The array, nothrow and sized forms all end up in these two, the aligned ones aren't counted
+void *operator new(std::size_t size)
+{
+    if (void *memory = countedAllocate(size)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <QtGlobal>
+
+namespace BreezyBench
+{
+    // Every operator new in the process, Qt's and the scene graph's included, counted by the replacement in
+    // breezybenchallocations.cpp. The QML engine's JavaScript heap is managed by the engine itself and isn't in here.
+    struct AllocationCounters {
+        quint64 count = 0;
+        quint64 bytes = 0;
+    };
+
+    AllocationCounters allocations();
+
+} // namespace BreezyBench
@@ -0,0 +1,135 @@
+#include "breezybencheffect.h"
+
+#include <QDateTime>
+#include <QtMath>
+
+#include <cmath>
+
+namespace BreezyBench
+{
+
+namespace
+{
+    // a head looking around the displays: a slow side to side sweep with some nodding, both out of phase so the
+    // focused display keeps changing
+    constexpr double YAW_AMPLITUDE_DEGREES = 30.0;
+    constexpr double YAW_PERIOD_SECONDS = 4.0;
+    constexpr double PITCH_AMPLITUDE_DEGREES = 8.0;
+    constexpr double PITCH_PERIOD_SECONDS = 3.0;
+
+    // time between the two orientations the driver writes, and how old the newest one is when it's read
+    constexpr std::chrono::milliseconds IMU_SAMPLE_INTERVAL{4};
+    constexpr std::chrono::milliseconds IMU_LATENCY{2};
+
+    // the EUS orientation updatePose() would produce for this point of the simulated motion
+    QQuaternion orientationAt(std::chrono::nanoseconds time)
+    {
+        const double seconds = std::chrono::duration<double>(time).count();
+        const double yaw = YAW_AMPLITUDE_DEGREES * std::sin(2.0 * M_PI * seconds / YAW_PERIOD_SECONDS);
+        const double pitch = PITCH_AMPLITUDE_DEGREES * std::sin(2.0 * M_PI * seconds / PITCH_PERIOD_SECONDS);
+        return QQuaternion::fromEulerAngles(static_cast<float>(pitch), static_cast<float>(yaw), 0.0f);
+    }
+}
+
+BenchEffect::BenchEffect(const Options &options, QObject *parent)
+    : QObject(parent)
+    , m_lookAheadConfig{10.0, 0.0, 0.0, 0.0}
+    , m_displayResolution{1920, 1080}
+    , m_smoothFollowOrigin{QQuaternion(), QQuaternion()}
+    , m_antialiasingQuality(options.antialiasingQuality)
+    , m_curvedDisplay(options.curvedDisplay)
+    , m_developerMode(options.developerMode)
+    , m_lateLatchPose(options.lateLatchPose)
+    , m_assetsUrl(options.assetsUrl)
+{
+    setPose(std::chrono::nanoseconds::zero());
+}
+
+void BenchEffect::setPose(std::chrono::nanoseconds time)
+{
+    m_poseOrientations = {orientationAt(time), orientationAt(time - IMU_SAMPLE_INTERVAL)};
+    m_poseTimeElapsedMs = static_cast<quint32>(IMU_SAMPLE_INTERVAL.count());
+    m_poseTimestamp = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch() - IMU_LATENCY.count());
+}
+
+void BenchEffect::latchCameraPose()
+{
+    // same prediction as BreezyDesktopEffect::latchCameraPose()
+    const QVector3D eulerEnd = m_poseOrientations[0].toEulerAngles();
+    const QVector3D eulerStart = m_poseOrientations[1].toEulerAngles();
+    const QVector3D degreesPerMs = (eulerEnd - eulerStart) / static_cast<float>(m_poseTimeElapsedMs);
+    const qreal dataAge = QDateTime::currentMSecsSinceEpoch() - static_cast<qint64>(m_poseTimestamp);
+    const float lookAheadMs = static_cast<float>(m_lookAheadConfig[0] + dataAge);
+
+    m_cameraEulerRotation = eulerEnd + degreesPerMs * lookAheadMs;
+    m_cameraOrientation = m_poseOrientations[0];
+    m_cameraAngularRates = degreesPerMs * qDegreesToRadians(1.0f);
+    ++m_cameraPosesApplied;
+    Q_EMIT cameraPoseLatched();
+}
+
+void BenchEffect::damageScreens(const QList<int> &screenIndices)
+{
+    Q_EMIT screenContentsDamaged(screenIndices);
+}
+
+QObject *BenchEffect::screenTextures() const
+{
+    // no KWin compositor to take output textures from, the displays sample their window thumbnails
+    return nullptr;
+}
+
+quint64 BenchEffect::cameraPosesApplied() const
+{
+    return m_cameraPosesApplied;
+}
+
+void BenchEffect::reportCameraPoseApplied(quint64 poseTimestamp)
+{
+    Q_UNUSED(poseTimestamp);
+    ++m_cameraPosesApplied;
+}
+
+void BenchEffect::setNativeScene(const QVariantMap &scene)
+{
+    Q_UNUSED(scene);
+}
+
+void BenchEffect::setCameraDistances(qreal lensDistancePixels, qreal fullScreenDistancePixels)
+{
+    Q_UNUSED(lensDistancePixels);
+    Q_UNUSED(fullScreenDistancePixels);
+}
+
+void BenchEffect::setDisplayBounds(int index, const QVector3D &center, qreal radius)
+{
+    Q_UNUSED(index);
+    Q_UNUSED(center);
+    Q_UNUSED(radius);
+}
+
+void BenchEffect::setDisplayMeshStats(int index, int vertexCount, qreal errorPixels)
+{
+    Q_UNUSED(index);
+    Q_UNUSED(vertexCount);
+    Q_UNUSED(errorPixels);
+}
+
+void BenchEffect::setDisplayPixelBudget(int index, qreal fullPixels, qreal renderedPixels, qreal visiblePixels)
+{
+    Q_UNUSED(index);
+    Q_UNUSED(fullPixels);
+    Q_UNUSED(renderedPixels);
+    Q_UNUSED(visiblePixels);
+}
+
+void BenchEffect::reportDisplayTextureUpdated()
+{
+}
+
+void BenchEffect::setHudRect(const QRectF &rect)
+{
+    Q_UNUSED(rect);
+}
+
+} // namespace BreezyBench
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <QList>
+#include <QObject>
+#include <QPointF>
+#include <QQuaternion>
+#include <QRectF>
+#include <QSize>
+#include <QUrl>
+#include <QVariantMap>
+#include <QVector3D>
+
+#include <chrono>
+
+namespace BreezyBench
+{
+    // Stands in for BreezyDesktopEffect as the scene's `effect`: the properties, slots and signals the QML uses, with
+    // the values the driver and the KCM would provide for a pair of glasses. Poses come from setPose() instead of the
+    // driver's IMU file. Keep it in sync with breezydesktopeffect.h when the QML starts using something new.
+    class BenchEffect : public QObject
+    {
+        Q_OBJECT
+        Q_PROPERTY(bool isEnabled MEMBER m_isEnabled CONSTANT)
+        Q_PROPERTY(int effectTargetScreenIndex MEMBER m_effectTargetScreenIndex)
+        Q_PROPERTY(bool zoomOnFocusEnabled MEMBER m_zoomOnFocusEnabled CONSTANT)
+        Q_PROPERTY(int lookingAtScreenIndex MEMBER m_lookingAtScreenIndex)
+        Q_PROPERTY(bool poseResetState MEMBER m_poseResetState CONSTANT)
+        Q_PROPERTY(bool poseHasPosition MEMBER m_poseHasPosition CONSTANT)
+        Q_PROPERTY(QList<QQuaternion> poseOrientations MEMBER m_poseOrientations)
+        Q_PROPERTY(QVector3D posePosition MEMBER m_posePosition)
+        Q_PROPERTY(quint32 poseTimeElapsedMs MEMBER m_poseTimeElapsedMs)
+        Q_PROPERTY(quint64 poseTimestamp MEMBER m_poseTimestamp)
+        Q_PROPERTY(QString cursorImageSource MEMBER m_cursorImageSource CONSTANT)
+        Q_PROPERTY(QSize cursorImageSize MEMBER m_cursorImageSize CONSTANT)
+        Q_PROPERTY(QPointF cursorPos MEMBER m_cursorPos CONSTANT)
+        Q_PROPERTY(QList<qreal> lookAheadConfig MEMBER m_lookAheadConfig CONSTANT)
+        Q_PROPERTY(qreal lookAheadOverride MEMBER m_lookAheadOverride CONSTANT)
+        Q_PROPERTY(QList<quint32> displayResolution MEMBER m_displayResolution CONSTANT)
+        Q_PROPERTY(qreal focusedDisplayDistance MEMBER m_focusedDisplayDistance CONSTANT)
+        Q_PROPERTY(qreal allDisplaysDistance MEMBER m_allDisplaysDistance CONSTANT)
+        Q_PROPERTY(qreal displaySpacing MEMBER m_displaySpacing CONSTANT)
+        Q_PROPERTY(qreal displaySize MEMBER m_displaySize CONSTANT)
+        Q_PROPERTY(qreal displayHorizontalOffset MEMBER m_displayHorizontalOffset CONSTANT)
+        Q_PROPERTY(qreal displayVerticalOffset MEMBER m_displayVerticalOffset CONSTANT)
+        Q_PROPERTY(int displayWrappingScheme MEMBER m_displayWrappingScheme CONSTANT)
+        Q_PROPERTY(qreal diagonalFOV MEMBER m_diagonalFOV CONSTANT)
+        Q_PROPERTY(qreal lensDistanceRatio MEMBER m_lensDistanceRatio CONSTANT)
+        Q_PROPERTY(bool sbsEnabled MEMBER m_sbsEnabled CONSTANT)
+        Q_PROPERTY(bool smoothFollowEnabled MEMBER m_smoothFollowEnabled CONSTANT)
+        Q_PROPERTY(QList<QQuaternion> smoothFollowOrigin MEMBER m_smoothFollowOrigin)
+        Q_PROPERTY(bool customBannerEnabled MEMBER m_customBannerEnabled CONSTANT)
+        Q_PROPERTY(int antialiasingQuality MEMBER m_antialiasingQuality CONSTANT)
+        Q_PROPERTY(int effectiveAntialiasingQuality MEMBER m_antialiasingQuality CONSTANT)
+        Q_PROPERTY(qreal renderScale MEMBER m_renderScale CONSTANT)
+        Q_PROPERTY(bool removeVirtualDisplaysOnDisable MEMBER m_removeVirtualDisplaysOnDisable CONSTANT)
+        Q_PROPERTY(bool mirrorPhysicalDisplays MEMBER m_mirrorPhysicalDisplays CONSTANT)
+        Q_PROPERTY(bool curvedDisplay MEMBER m_curvedDisplay CONSTANT)
+        Q_PROPERTY(bool curvedDisplaySupported MEMBER m_curvedDisplaySupported)
+        Q_PROPERTY(bool developerMode MEMBER m_developerMode CONSTANT)
+        Q_PROPERTY(bool lateLatchPose MEMBER m_lateLatchPose CONSTANT)
+        Q_PROPERTY(int renderBackend MEMBER m_renderBackend NOTIFY renderBackendChanged)
+        Q_PROPERTY(int culledDisplayMask MEMBER m_culledDisplayMask CONSTANT)
+        Q_PROPERTY(int displayTextureSource MEMBER m_displayTextureSource CONSTANT)
+        Q_PROPERTY(bool animationsActive MEMBER m_animationsActive)
+        Q_PROPERTY(bool instancedDisplays MEMBER m_instancedDisplays CONSTANT)
+        Q_PROPERTY(bool instancedDisplaysActive MEMBER m_instancedDisplaysActive)
+        Q_PROPERTY(bool focusLodEnabled MEMBER m_focusLodEnabled CONSTANT)
+        Q_PROPERTY(qreal unfocusedTextureScale MEMBER m_unfocusedTextureScale CONSTANT)
+        Q_PROPERTY(bool distanceTextureScaling MEMBER m_distanceTextureScaling CONSTANT)
+        Q_PROPERTY(QObject *screenTextures READ screenTextures CONSTANT)
+        Q_PROPERTY(QVariantMap textureUpdateRates MEMBER m_textureUpdateRates CONSTANT)
+        Q_PROPERTY(QUrl assetsUrl MEMBER m_assetsUrl CONSTANT)
+        Q_PROPERTY(QVector3D cameraEulerRotation MEMBER m_cameraEulerRotation)
+        Q_PROPERTY(QQuaternion cameraOrientation MEMBER m_cameraOrientation)
+        Q_PROPERTY(QVector3D cameraAngularRates MEMBER m_cameraAngularRates)
+        Q_PROPERTY(QVariantMap hudStatistics MEMBER m_hudStatistics CONSTANT)
+
+    public:
+        struct Options {
+            int antialiasingQuality = 3;
+            bool curvedDisplay = false;
+            bool lateLatchPose = false;
+            bool developerMode = false;
+            QUrl assetsUrl;
+        };
+
+        explicit BenchEffect(const Options &options, QObject *parent = nullptr);
+
+        // the simulated head pose at the given time since the start of the run, as the driver would have written it
+        void setPose(std::chrono::nanoseconds time);
+
+        // what the effect does before rendering when the pose is late-latched: predicts the camera and tells the scene
+        void latchCameraPose();
+
+        // the screens the scene renders, in Workspace.screens order, for the per-frame damage
+        void damageScreens(const QList<int> &screenIndices);
+
+        QObject *screenTextures() const;
+
+        quint64 cameraPosesApplied() const;
+
+    public Q_SLOTS:
+        void reportCameraPoseApplied(quint64 poseTimestamp);
+        void setNativeScene(const QVariantMap &scene);
+        void setCameraDistances(qreal lensDistancePixels, qreal fullScreenDistancePixels);
+        void setDisplayBounds(int index, const QVector3D &center, qreal radius);
+        void setDisplayMeshStats(int index, int vertexCount, qreal errorPixels);
+        void setDisplayPixelBudget(int index, qreal fullPixels, qreal renderedPixels, qreal visiblePixels);
+        void reportDisplayTextureUpdated();
+        void setHudRect(const QRectF &rect);
+
+    Q_SIGNALS:
+        void renderBackendChanged();
+        void screenContentsDamaged(const QList<int> &screenIndices);
+        void cameraPoseLatched();
+
+    private:
+        bool m_isEnabled = true;
+        int m_effectTargetScreenIndex = -1;
+        bool m_zoomOnFocusEnabled = false;
+        int m_lookingAtScreenIndex = -1;
+        bool m_poseResetState = false;
+        bool m_poseHasPosition = false;
+        QList<QQuaternion> m_poseOrientations;
+        QVector3D m_posePosition;
+        quint32 m_poseTimeElapsedMs = 0;
+        quint64 m_poseTimestamp = 0;
+        QString m_cursorImageSource;
+        QSize m_cursorImageSize;
+        QPointF m_cursorPos{-1.0, -1.0};
+        QList<qreal> m_lookAheadConfig;
+        qreal m_lookAheadOverride = -1.0;
+        QList<quint32> m_displayResolution;
+        qreal m_focusedDisplayDistance = 0.85;
+        qreal m_allDisplaysDistance = 1.05;
+        qreal m_displaySpacing = 0.0;
+        qreal m_displaySize = 1.0;
+        qreal m_displayHorizontalOffset = 0.0;
+        qreal m_displayVerticalOffset = 0.0;
+        int m_displayWrappingScheme = 0;
+        qreal m_diagonalFOV = 46.0;
+        qreal m_lensDistanceRatio = 0.035;
+        bool m_sbsEnabled = false;
+        bool m_smoothFollowEnabled = false;
+        QList<QQuaternion> m_smoothFollowOrigin;
+        bool m_customBannerEnabled = false;
+        int m_antialiasingQuality = 3;
+        qreal m_renderScale = 1.0;
+        bool m_removeVirtualDisplaysOnDisable = true;
+        bool m_mirrorPhysicalDisplays = false;
+        bool m_curvedDisplay = false;
+        bool m_curvedDisplaySupported = false;
+        bool m_developerMode = false;
+        bool m_lateLatchPose = false;
+        int m_renderBackend = 0;
+        int m_culledDisplayMask = 0;
+        int m_displayTextureSource = 0;
+        bool m_animationsActive = false;
+        bool m_instancedDisplays = false;
+        bool m_instancedDisplaysActive = false;
+        bool m_focusLodEnabled = true;
+        qreal m_unfocusedTextureScale = 0.5;
+        bool m_distanceTextureScaling = false;
+        QUrl m_assetsUrl;
+        QVector3D m_cameraEulerRotation;
+        QQuaternion m_cameraOrientation;
+        QVector3D m_cameraAngularRates;
+        QVariantMap m_hudStatistics;
+        QVariantMap m_textureUpdateRates;
+
+        quint64 m_cameraPosesApplied = 0;
+    };
+
+} // namespace BreezyBench
@@ -0,0 +1,193 @@
+#include "breezybenchkwin.h"
+
+#include <QQmlEngine>
+#include <QUrl>
+
+namespace BreezyBench
+{
+
+namespace
+{
+    BenchWorkspace *s_workspace = nullptr;
+
+    // what Workspace.screens reports for the glasses, one of main.qml's supportedModels
+    const QString GLASSES_MODEL = QStringLiteral("XREAL One");
+}
+
+BenchScreen::BenchScreen(const QString &name, const QString &model, const QRect &geometry, QObject *parent)
+    : QObject(parent)
+    , m_geometry(geometry)
+    , m_name(name)
+    , m_model(model)
+{
+}
+
+QRect BenchScreen::geometry() const
+{
+    return m_geometry;
+}
+
+BenchWindow::BenchWindow(const QRect &geometry, int stackingOrder, QObject *parent)
+    : QObject(parent)
+    , m_internalId(QUuid::createUuid())
+    , m_geometry(geometry)
+    , m_stackingOrder(stackingOrder)
+{
+}
+
+QUuid BenchWindow::internalId() const
+{
+    return m_internalId;
+}
+
+QRect BenchWindow::geometry() const
+{
+    return m_geometry;
+}
+
+qreal BenchWindow::x() const
+{
+    return m_geometry.x();
+}
+
+qreal BenchWindow::y() const
+{
+    return m_geometry.y();
+}
+
+qreal BenchWindow::width() const
+{
+    return m_geometry.width();
+}
+
+qreal BenchWindow::height() const
+{
+    return m_geometry.height();
+}
+
+BenchWorkspace::BenchWorkspace(QObject *parent)
+    : QObject(parent)
+{
+    s_workspace = this;
+}
+
+BenchWorkspace::~BenchWorkspace()
+{
+    if (s_workspace == this) s_workspace = nullptr;
+}
+
+BenchWorkspace *BenchWorkspace::self()
+{
+    return s_workspace;
+}
+
+void BenchWorkspace::setLayout(int screenCount, QSize screenSize, int windowsPerScreen)
+{
+    qDeleteAll(m_windows);
+    m_windows.clear();
+    qDeleteAll(m_screens);
+    m_screens.clear();
+
+    int stackingOrder = 0;
+    for (int i = 0; i < screenCount; ++i) {
+        const QRect geometry(QPoint(i * screenSize.width(), 0), screenSize);
+        if (i == 0) {
+            m_screens.append(new BenchScreen(QStringLiteral("DP-1"), GLASSES_MODEL, geometry, this));
+        } else {
+            m_screens.append(new BenchScreen(QStringLiteral("BreezyDesktop_%1").arg(i), QStringLiteral("Virtual"), geometry, this));
+        }
+
+        // cascaded, so the thumbnails overlap like real windows do
+        for (int w = 0; w < windowsPerScreen; ++w) {
+            const QPoint offset(w * screenSize.width() / 16, w * screenSize.height() / 16);
+            const QRect windowGeometry(geometry.topLeft() + offset, screenSize * 0.75);
+            m_windows.append(new BenchWindow(windowGeometry, stackingOrder++, this));
+        }
+    }
+    Q_EMIT screensChanged();
+}
+
+QList<QObject *> BenchWorkspace::screens() const
+{
+    return QList<QObject *>(m_screens.cbegin(), m_screens.cend());
+}
+
+QList<BenchWindow *> BenchWorkspace::windows() const
+{
+    return m_windows;
+}
+
+QObject *BenchWorkspace::windowById(const QVariant &internalId) const
+{
+    const QUuid id = internalId.toUuid();
+    for (BenchWindow *window : m_windows) {
+        if (window->internalId() == id) return window;
+    }
+    return nullptr;
+}
+
+BenchWindowModel::BenchWindowModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_windows(BenchWorkspace::self() ? BenchWorkspace::self()->windows() : QList<BenchWindow *>())
+{
+}
+
+int BenchWindowModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_windows.size();
+}
+
+QVariant BenchWindowModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_windows.size() || role != WindowRole) return QVariant();
+    return QVariant::fromValue<QObject *>(m_windows[index.row()]);
+}
+
+QHash<int, QByteArray> BenchWindowModel::roleNames() const
+{
+    return {{WindowRole, QByteArrayLiteral("window")}};
+}
+
+BenchWindowFilterModel::BenchWindowFilterModel(QObject *parent)
+    : QSortFilterProxyModel(parent)
+{
+}
+
+QObject *BenchWindowFilterModel::screen() const
+{
+    return m_screen;
+}
+
+void BenchWindowFilterModel::setScreen(QObject *screen)
+{
+    BenchScreen *benchScreen = qobject_cast<BenchScreen *>(screen);
+    if (m_screen == benchScreen) return;
+    m_screen = benchScreen;
+    invalidateFilter();
+    Q_EMIT screenChanged();
+}
+
+bool BenchWindowFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+    if (!m_screen) return false;
+    const QModelIndex index = sourceModel()->index(sourceRow, 0, sourceParent);
+    const auto *window = qobject_cast<BenchWindow *>(index.data(BenchWindowModel::WindowRole).value<QObject *>());
+    return window && window->geometry().intersects(m_screen->geometry());
+}
+
+BenchOutputTexture::BenchOutputTexture(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+}
+
+void registerTypes(BenchWorkspace *workspace)
+{
+    qmlRegisterSingletonInstance("org.kde.kwin", 3, 0, "Workspace", workspace);
+    qmlRegisterType<BenchWindowModel>("org.kde.kwin", 3, 0, "WindowModel");
+    qmlRegisterType(QUrl(QStringLiteral("qrc:/bench/qml/WindowThumbnail.qml")), "org.kde.kwin", 3, 0, "WindowThumbnail");
+
+    qmlRegisterType<BenchWindowFilterModel>("org.kde.kwin.effect.breezy_desktop", 1, 0, "WindowFilterModel");
+    qmlRegisterType<BenchOutputTexture>("org.kde.kwin.effect.breezy_desktop", 1, 0, "OutputTexture");
+}
+
+} // namespace BreezyBench
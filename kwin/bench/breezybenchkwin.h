@@ -0,0 +1,170 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QQuickItem>
+#include <QRect>
+#include <QSortFilterProxyModel>
+#include <QUuid>
+#include <QVariantList>
+
+namespace BreezyBench
+{
+    // Stand-ins for the parts of KWin's org.kde.kwin QML module and of the effect's own types the scene uses, see
+    // registerTypes(). They carry the same properties as the real ones, but nothing is composited.
+
+    // an Output, as seen through Workspace.screens
+    class BenchScreen : public QObject
+    {
+        Q_OBJECT
+        Q_PROPERTY(QRect geometry MEMBER m_geometry CONSTANT)
+        Q_PROPERTY(qreal devicePixelRatio MEMBER m_devicePixelRatio CONSTANT)
+        Q_PROPERTY(QString name MEMBER m_name CONSTANT)
+        Q_PROPERTY(QString model MEMBER m_model CONSTANT)
+
+    public:
+        BenchScreen(const QString &name, const QString &model, const QRect &geometry, QObject *parent = nullptr);
+
+        QRect geometry() const;
+
+    private:
+        QRect m_geometry;
+        qreal m_devicePixelRatio = 1.0;
+        QString m_name;
+        QString m_model;
+    };
+
+    // a client window, as seen through WindowModel's "window" role
+    class BenchWindow : public QObject
+    {
+        Q_OBJECT
+        Q_PROPERTY(QUuid internalId MEMBER m_internalId CONSTANT)
+        Q_PROPERTY(qreal x READ x CONSTANT)
+        Q_PROPERTY(qreal y READ y CONSTANT)
+        Q_PROPERTY(qreal width READ width CONSTANT)
+        Q_PROPERTY(qreal height READ height CONSTANT)
+        Q_PROPERTY(int stackingOrder MEMBER m_stackingOrder CONSTANT)
+
+    public:
+        BenchWindow(const QRect &geometry, int stackingOrder, QObject *parent = nullptr);
+
+        QUuid internalId() const;
+        QRect geometry() const;
+        qreal x() const;
+        qreal y() const;
+        qreal width() const;
+        qreal height() const;
+
+    private:
+        QUuid m_internalId;
+        QRect m_geometry;
+        int m_stackingOrder = 0;
+    };
+
+    // the Workspace singleton; the bench lays out its screens and windows before each scene is loaded
+    class BenchWorkspace : public QObject
+    {
+        Q_OBJECT
+        Q_PROPERTY(QList<QObject *> screens READ screens NOTIFY screensChanged)
+
+    public:
+        explicit BenchWorkspace(QObject *parent = nullptr);
+        ~BenchWorkspace() override;
+
+        static BenchWorkspace *self();
+
+        // the glasses' own screen at the origin and the rest as virtual displays to its right, all the same size,
+        // each covered by the given number of windows
+        void setLayout(int screenCount, QSize screenSize, int windowsPerScreen);
+
+        QList<QObject *> screens() const;
+        QList<BenchWindow *> windows() const;
+
+        // not in KWin's Workspace, lets the thumbnail stand-in find its window's size
+        Q_INVOKABLE QObject *windowById(const QVariant &internalId) const;
+
+    Q_SIGNALS:
+        void screensChanged();
+
+    private:
+        QList<BenchScreen *> m_screens;
+        QList<BenchWindow *> m_windows;
+    };
+
+    class BenchWindowModel : public QAbstractListModel
+    {
+        Q_OBJECT
+
+    public:
+        enum Roles {
+            WindowRole = Qt::UserRole + 1,
+        };
+
+        explicit BenchWindowModel(QObject *parent = nullptr);
+
+        int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+        QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+        QHash<int, QByteArray> roleNames() const override;
+
+    private:
+        QList<BenchWindow *> m_windows;
+    };
+
+    // BreezyDesktopWindowFilterModel without desktops, activities and minimized windows: overlapping the screen is enough
+    class BenchWindowFilterModel : public QSortFilterProxyModel
+    {
+        Q_OBJECT
+        Q_PROPERTY(QObject *screen READ screen WRITE setScreen NOTIFY screenChanged)
+
+    public:
+        explicit BenchWindowFilterModel(QObject *parent = nullptr);
+
+        QObject *screen() const;
+        void setScreen(QObject *screen);
+
+    Q_SIGNALS:
+        void screenChanged();
+
+    protected:
+        bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+    private:
+        QPointer<BenchScreen> m_screen;
+    };
+
+    // BreezyDesktopOutputTextureItem's interface; the bench has no screen texture cache, so it never draws
+    class BenchOutputTexture : public QQuickItem
+    {
+        Q_OBJECT
+        Q_PROPERTY(QObject *screen MEMBER m_screen NOTIFY screenChanged)
+        Q_PROPERTY(QObject *textureCache MEMBER m_textureCache NOTIFY textureCacheChanged)
+        Q_PROPERTY(qreal textureScale MEMBER m_textureScale NOTIFY textureScaleChanged)
+        Q_PROPERTY(bool mipmaps MEMBER m_mipmaps NOTIFY mipmapsChanged)
+        Q_PROPERTY(QVariantList atlasScreens MEMBER m_atlasScreens NOTIFY atlasScreensChanged)
+        Q_PROPERTY(QVariantList atlasRects MEMBER m_atlasRects CONSTANT)
+
+    public:
+        explicit BenchOutputTexture(QQuickItem *parent = nullptr);
+
+    Q_SIGNALS:
+        void screenChanged();
+        void textureCacheChanged();
+        void textureScaleChanged();
+        void mipmapsChanged();
+        void atlasScreensChanged();
+
+    private:
+        QObject *m_screen = nullptr;
+        QObject *m_textureCache = nullptr;
+        qreal m_textureScale = 1.0;
+        bool m_mipmaps = false;
+        QVariantList m_atlasScreens;
+        QVariantList m_atlasRects;
+    };
+
+    // registers the stand-ins as org.kde.kwin and org.kde.kwin.effect.breezy_desktop, before any scene is loaded
+    void registerTypes(BenchWorkspace *workspace);
+
+} // namespace BreezyBench
@@ -0,0 +1,434 @@
+// breezy_bench: renders the effect's QML scene offscreen, the way QuickSceneEffect would for the glasses' screen,
+// with mock KWin types and a mock effect, and reports what each frame cost. Every combination of the requested
+// display counts, antialiasing levels and display modes is loaded into a fresh engine and window, warmed up, then
+// timed over a fixed number of frames driven by a simulated head motion.
+//
+// A frame is split into:
+//   script:  the GUI thread work before rendering, where the scene's bindings and handlers run: queued events and
+//            timers, the new pose and screen damage, and the animation tick (FrameAnimation, Behaviors, ...)
+//   polish:  QQuickRenderControl::polishItems()
+//   render:  sync, render and waiting for the GPU to finish the frame
+// Allocations are operator new calls and bytes within the frame, see breezybenchallocations.h.
+
+#include "breezybenchallocations.h"
+#include "breezybencheffect.h"
+#include "breezybenchkwin.h"
+
+#include <QAnimationDriver>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QGuiApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QQuickRenderControl>
+#include <QQuickRenderTarget>
+#include <QQuickWindow>
+#include <QSurfaceFormat>
+#include <QtQuick3D/qquick3d.h>
+
+#include <rhi/qrhi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace BreezyBench;
+using namespace std::chrono_literals;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::chrono::nanoseconds FRAME_INTERVAL = 16667us;
+
+    double elapsedMs(Clock::time_point from, Clock::time_point to)
+    {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+
+    // Steps animations by exactly one frame per advance(), so every run animates the same way however long the
+    // frames actually take.
+    class BenchAnimationDriver : public QAnimationDriver
+    {
+    public:
+        void advance() override
+        {
+            m_elapsed += FRAME_INTERVAL;
+            advanceAnimation();
+        }
+
+        qint64 elapsed() const override
+        {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(m_elapsed).count();
+        }
+
+        std::chrono::nanoseconds time() const
+        {
+            return m_elapsed;
+        }
+
+    private:
+        std::chrono::nanoseconds m_elapsed{0};
+    };
+
+    // every sample, so percentiles are exact
+    struct Samples {
+        std::vector<double> values;
+
+        void add(double value)
+        {
+            values.push_back(value);
+        }
+
+        double average() const
+        {
+            if (values.empty()) return 0.0;
+            double sum = 0.0;
+            for (double value : values) sum += value;
+            return sum / values.size();
+        }
+
+        // p in [0, 1]
+        double percentile(double p) const
+        {
+            if (values.empty()) return 0.0;
+            std::vector<double> sorted = values;
+            std::sort(sorted.begin(), sorted.end());
+            const size_t rank = std::max<size_t>(1, static_cast<size_t>(std::ceil(p * sorted.size())));
+            return sorted[std::min(rank, sorted.size()) - 1];
+        }
+
+        QJsonObject toJson() const
+        {
+            return QJsonObject{
+                {QStringLiteral("avg"), average()},
+                {QStringLiteral("p50"), percentile(0.50)},
+                {QStringLiteral("p95"), percentile(0.95)},
+                {QStringLiteral("p99"), percentile(0.99)},
+                {QStringLiteral("max"), percentile(1.0)},
+            };
+        }
+    };
+
+    struct Options {
+        QUrl scene;
+        QSize size;
+        int frames = 600;
+        int warmupFrames = 60;
+        int windowsPerScreen = 3;
+        bool lateLatchPose = false;
+        bool developerMode = false;
+    };
+
+    struct Configuration {
+        int displays = 1;
+        int antialiasingQuality = 3;
+        bool curved = false;
+    };
+
+    struct Result {
+        Configuration configuration;
+        bool ok = false;
+        double loadMs = 0.0;
+        double firstFrameMs = 0.0; // including shader and pipeline creation
+        Samples frameMs;
+        Samples scriptMs;
+        Samples polishMs;
+        Samples renderMs;
+        Samples allocations;
+        Samples allocatedKiB;
+    };
+
+    QList<int> parseIntList(const QString &value, bool *ok)
+    {
+        QList<int> values;
+        *ok = true;
+        for (const QString &part : value.split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+            bool partOk = false;
+            values.append(part.trimmed().toInt(&partOk));
+            *ok = *ok && partOk;
+        }
+        *ok = *ok && !values.isEmpty();
+        return values;
+    }
+
+    Result runConfiguration(const Configuration &configuration, const Options &options, BenchAnimationDriver &animationDriver)
+    {
+        Result result;
+        result.configuration = configuration;
+
+        BenchWorkspace::self()->setLayout(configuration.displays, options.size, options.windowsPerScreen);
+        QList<int> screenIndices;
+        for (int i = 0; i < configuration.displays; ++i) screenIndices.append(i);
+
+        BenchEffect::Options effectOptions;
+        effectOptions.antialiasingQuality = configuration.antialiasingQuality;
+        effectOptions.curvedDisplay = configuration.curved;
+        effectOptions.lateLatchPose = options.lateLatchPose;
+        effectOptions.developerMode = options.developerMode;
+        effectOptions.assetsUrl = options.scene.resolved(QUrl(QStringLiteral(".")));
+        BenchEffect effect(effectOptions);
+
+        auto renderControl = std::make_unique<QQuickRenderControl>();
+        auto window = std::make_unique<QQuickWindow>(renderControl.get());
+        window->setGeometry(QRect(QPoint(), options.size));
+        if (!renderControl->initialize()) {
+            std::fprintf(stderr, "breezy_bench: failed to initialize the scene graph's graphics API\n");
+            return result;
+        }
+
+        QRhi *rhi = renderControl->rhi();
+        std::unique_ptr<QRhiTexture> texture(rhi->newTexture(QRhiTexture::RGBA8, options.size, 1, QRhiTexture::RenderTarget));
+        std::unique_ptr<QRhiRenderBuffer> depthStencil(rhi->newRenderBuffer(QRhiRenderBuffer::DepthStencil, options.size, 1));
+        if (!texture->create() || !depthStencil->create()) {
+            std::fprintf(stderr, "breezy_bench: failed to create the %dx%d render target\n", options.size.width(), options.size.height());
+            return result;
+        }
+        QRhiTextureRenderTargetDescription renderTargetDescription((QRhiColorAttachment(texture.get())));
+        renderTargetDescription.setDepthStencilBuffer(depthStencil.get());
+        std::unique_ptr<QRhiTextureRenderTarget> renderTarget(rhi->newTextureRenderTarget(renderTargetDescription));
+        std::unique_ptr<QRhiRenderPassDescriptor> renderPass(renderTarget->newCompatibleRenderPassDescriptor());
+        renderTarget->setRenderPassDescriptor(renderPass.get());
+        renderTarget->create();
+        window->setRenderTarget(QQuickRenderTarget::fromRhiRenderTarget(renderTarget.get()));
+
+        const Clock::time_point loadStart = Clock::now();
+        auto engine = std::make_unique<QQmlEngine>();
+        // KWin's QuickSceneEffect makes the effect available to every file in the scene, not just main.qml
+        engine->rootContext()->setContextProperty(QStringLiteral("effect"), &effect);
+        auto component = std::make_unique<QQmlComponent>(engine.get(), options.scene);
+        QObject *targetScreen = BenchWorkspace::self()->screens().constFirst();
+        std::unique_ptr<QQuickItem> root(qobject_cast<QQuickItem *>(component->createWithInitialProperties({
+            {QStringLiteral("effect"), QVariant::fromValue<QObject *>(&effect)},
+            {QStringLiteral("targetScreen"), QVariant::fromValue(targetScreen)},
+        })));
+        if (root) {
+            root->setParentItem(window->contentItem());
+            root->setSize(options.size);
+            result.loadMs = elapsedMs(loadStart, Clock::now());
+
+            for (int frame = 0; frame < options.warmupFrames + options.frames; ++frame) {
+                const AllocationCounters allocationsBefore = allocations();
+                const Clock::time_point start = Clock::now();
+
+                QCoreApplication::processEvents();
+                effect.setPose(animationDriver.time());
+                effect.damageScreens(screenIndices);
+                animationDriver.advance();
+                if (options.lateLatchPose) effect.latchCameraPose();
+                const Clock::time_point scripted = Clock::now();
+
+                renderControl->polishItems();
+                const Clock::time_point polished = Clock::now();
+
+                renderControl->beginFrame();
+                renderControl->sync();
+                renderControl->render();
+                renderControl->endFrame();
+                rhi->finish();
+                const Clock::time_point end = Clock::now();
+                const AllocationCounters allocationsAfter = allocations();
+
+                if (frame == 0) result.firstFrameMs = elapsedMs(start, end);
+                if (frame < options.warmupFrames) continue;
+                result.frameMs.add(elapsedMs(start, end));
+                result.scriptMs.add(elapsedMs(start, scripted));
+                result.polishMs.add(elapsedMs(scripted, polished));
+                result.renderMs.add(elapsedMs(polished, end));
+                result.allocations.add(allocationsAfter.count - allocationsBefore.count);
+                result.allocatedKiB.add((allocationsAfter.bytes - allocationsBefore.bytes) / 1024.0);
+            }
+            result.ok = true;
+        } else {
+            for (const QQmlError &error : component->errors()) {
+                std::fprintf(stderr, "breezy_bench: %s\n", qPrintable(error.toString()));
+            }
+        }
+
+        // the scene before the engine, and the graphics resources before the RHI that owns them goes with the window
+        root.reset();
+        component.reset();
+        engine.reset();
+        window->setRenderTarget(QQuickRenderTarget());
+        renderPass.reset();
+        renderTarget.reset();
+        depthStencil.reset();
+        texture.reset();
+        window.reset();
+        renderControl.reset();
+        return result;
+    }
+
+    QString modeName(bool curved)
+    {
+        return curved ? QStringLiteral("curved") : QStringLiteral("flat");
+    }
+
+    void printHeader()
+    {
+        std::printf("%8s %3s %7s | %-27s | %-15s | %6s | %-15s | %12s %10s | %8s %11s\n",
+                    "displays", "aa", "mode",
+                    "frame ms p50/p95/p99/max", "script p50/p95", "polish", "render p50/p95",
+                    "allocs/frame", "KiB/frame", "load ms", "1st frame");
+    }
+
+    void printResult(const Result &result)
+    {
+        const Configuration &c = result.configuration;
+        if (!result.ok) {
+            std::printf("%8d %3d %7s | failed to load the scene\n", c.displays, c.antialiasingQuality, qPrintable(modeName(c.curved)));
+            return;
+        }
+        std::printf("%8d %3d %7s | %6.2f %6.2f %6.2f %6.2f | %7.2f %7.2f | %6.2f | %7.2f %7.2f | %12.0f %10.1f | %8.0f %11.1f\n",
+                    c.displays, c.antialiasingQuality, qPrintable(modeName(c.curved)),
+                    result.frameMs.percentile(0.50), result.frameMs.percentile(0.95),
+                    result.frameMs.percentile(0.99), result.frameMs.percentile(1.0),
+                    result.scriptMs.percentile(0.50), result.scriptMs.percentile(0.95),
+                    result.polishMs.percentile(0.50),
+                    result.renderMs.percentile(0.50), result.renderMs.percentile(0.95),
+                    result.allocations.average(), result.allocatedKiB.average(),
+                    result.loadMs, result.firstFrameMs);
+        std::fflush(stdout);
+    }
+
+    QJsonObject resultToJson(const Result &result)
+    {
+        const Configuration &c = result.configuration;
+        QJsonObject json{
+            {QStringLiteral("displays"), c.displays},
+            {QStringLiteral("antialiasingQuality"), c.antialiasingQuality},
+            {QStringLiteral("mode"), modeName(c.curved)},
+            {QStringLiteral("ok"), result.ok},
+        };
+        if (!result.ok) return json;
+        json.insert(QStringLiteral("frames"), static_cast<qint64>(result.frameMs.values.size()));
+        json.insert(QStringLiteral("loadMs"), result.loadMs);
+        json.insert(QStringLiteral("firstFrameMs"), result.firstFrameMs);
+        json.insert(QStringLiteral("frameMs"), result.frameMs.toJson());
+        json.insert(QStringLiteral("scriptMs"), result.scriptMs.toJson());
+        json.insert(QStringLiteral("polishMs"), result.polishMs.toJson());
+        json.insert(QStringLiteral("renderMs"), result.renderMs.toJson());
+        json.insert(QStringLiteral("allocationsPerFrame"), result.allocations.toJson());
+        json.insert(QStringLiteral("allocatedKiBPerFrame"), result.allocatedKiB.toJson());
+        return json;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // before the application, so the OpenGL backend gets a context Qt Quick 3D can use
+    QSurfaceFormat::setDefaultFormat(QQuick3D::idealSurfaceFormat());
+
+    QGuiApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("breezy_bench"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral(
+        "Renders the Breezy Desktop QML scene offscreen with a simulated head motion and reports per-frame costs. "
+        "The graphics API is Qt's default, QSG_RHI_BACKEND picks another one; QT_QPA_PLATFORM=offscreen runs it "
+        "without a display server."));
+    parser.addHelpOption();
+    const QCommandLineOption qmlDirOption(QStringLiteral("qml-dir"), QStringLiteral("Directory with the scene's main.qml."),
+                                          QStringLiteral("path"), QStringLiteral(BREEZY_BENCH_QML_DIR));
+    const QCommandLineOption framesOption(QStringLiteral("frames"), QStringLiteral("Frames measured per configuration."),
+                                          QStringLiteral("count"), QStringLiteral("600"));
+    const QCommandLineOption warmupOption(QStringLiteral("warmup"), QStringLiteral("Frames rendered before measuring."),
+                                          QStringLiteral("count"), QStringLiteral("60"));
+    const QCommandLineOption displaysOption(QStringLiteral("displays"), QStringLiteral("Comma separated display counts, the glasses' screen included."),
+                                            QStringLiteral("list"), QStringLiteral("1,3,6"));
+    const QCommandLineOption aaOption(QStringLiteral("aa"), QStringLiteral("Comma separated antialiasing levels: 0=None, 1=Medium, 2=High, 3=Very High."),
+                                      QStringLiteral("list"), QStringLiteral("0,3"));
+    const QCommandLineOption modesOption(QStringLiteral("modes"), QStringLiteral("Comma separated display modes: flat, curved."),
+                                         QStringLiteral("list"), QStringLiteral("flat,curved"));
+    const QCommandLineOption sizeOption(QStringLiteral("size"), QStringLiteral("Resolution of the glasses and of every display."),
+                                        QStringLiteral("WIDTHxHEIGHT"), QStringLiteral("1920x1080"));
+    const QCommandLineOption windowsOption(QStringLiteral("windows"), QStringLiteral("Window thumbnails per display."),
+                                           QStringLiteral("count"), QStringLiteral("3"));
+    const QCommandLineOption lateLatchOption(QStringLiteral("late-latch"), QStringLiteral("Late-latch the pose, as with the LateLatchPose setting."));
+    const QCommandLineOption developerModeOption(QStringLiteral("developer-mode"), QStringLiteral("Run the scene in developer mode."));
+    const QCommandLineOption jsonOption(QStringLiteral("json"), QStringLiteral("Also write the results to this file as JSON."),
+                                        QStringLiteral("file"));
+    parser.addOptions({qmlDirOption, framesOption, warmupOption, displaysOption, aaOption, modesOption, sizeOption,
+                       windowsOption, lateLatchOption, developerModeOption, jsonOption});
+    parser.process(app);
+
+    Options options;
+    options.scene = QUrl::fromLocalFile(QDir(parser.value(qmlDirOption)).absoluteFilePath(QStringLiteral("main.qml")));
+    options.frames = parser.value(framesOption).toInt();
+    options.warmupFrames = std::max(0, parser.value(warmupOption).toInt());
+    options.windowsPerScreen = std::max(0, parser.value(windowsOption).toInt());
+    options.lateLatchPose = parser.isSet(lateLatchOption);
+    options.developerMode = parser.isSet(developerModeOption);
+
+    const QStringList size = parser.value(sizeOption).split(QLatin1Char('x'));
+    if (size.size() == 2) options.size = QSize(size[0].toInt(), size[1].toInt());
+
+    bool displaysOk = false;
+    bool aaOk = false;
+    const QList<int> displayCounts = parseIntList(parser.value(displaysOption), &displaysOk);
+    const QList<int> aaLevels = parseIntList(parser.value(aaOption), &aaOk);
+    QList<bool> modes;
+    for (const QString &mode : parser.value(modesOption).split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+        if (mode.trimmed() == QLatin1String("flat")) modes.append(false);
+        else if (mode.trimmed() == QLatin1String("curved")) modes.append(true);
+    }
+
+    const bool displayCountsValid = std::all_of(displayCounts.cbegin(), displayCounts.cend(), [](int count) { return count >= 1; });
+    const bool aaLevelsValid = std::all_of(aaLevels.cbegin(), aaLevels.cend(), [](int level) { return level >= 0 && level <= 3; });
+    if (!displaysOk || !displayCountsValid || !aaOk || !aaLevelsValid || modes.isEmpty() || options.frames <= 0 || options.size.isEmpty()) {
+        std::fprintf(stderr, "breezy_bench: invalid options, see --help\n");
+        return 1;
+    }
+    if (!QFile::exists(options.scene.toLocalFile())) {
+        std::fprintf(stderr, "breezy_bench: %s not found, see --qml-dir\n", qPrintable(options.scene.toLocalFile()));
+        return 1;
+    }
+
+    BenchWorkspace workspace;
+    registerTypes(&workspace);
+
+    BenchAnimationDriver animationDriver;
+    animationDriver.install();
+
+    std::printf("%s, %dx%d, %d frames after %d warm-up, %d windows per display%s%s\n",
+                qPrintable(options.scene.toLocalFile()), options.size.width(), options.size.height(),
+                options.frames, options.warmupFrames, options.windowsPerScreen,
+                options.lateLatchPose ? ", late-latched pose" : "",
+                options.developerMode ? ", developer mode" : "");
+    printHeader();
+
+    QJsonArray results;
+    bool allOk = true;
+    for (int displays : displayCounts) {
+        for (int aa : aaLevels) {
+            for (bool curved : modes) {
+                const Result result = runConfiguration({displays, aa, curved}, options, animationDriver);
+                printResult(result);
+                results.append(resultToJson(result));
+                allOk = allOk && result.ok;
+            }
+        }
+    }
+
+    animationDriver.uninstall();
+
+    if (parser.isSet(jsonOption)) {
+        QFile file(parser.value(jsonOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::fprintf(stderr, "breezy_bench: can't write %s\n", qPrintable(file.fileName()));
+            return 1;
+        }
+        file.write(QJsonDocument(results).toJson());
+    }
+
+    return allOk ? 0 : 1;
+}
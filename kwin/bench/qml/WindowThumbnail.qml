@@ -0,0 +1,41 @@
+import QtQuick
+import org.kde.kwin as KWinComponents
+
+// Stands in for KWin's WindowThumbnail: a static picture of a window at the window's size, with a title bar and
+// enough detail that the display textures aren't a flat color.
+Rectangle {
+    id: thumbnail
+
+    property var wId
+    readonly property QtObject window: KWinComponents.Workspace.windowById(wId)
+
+    width: window ? window.width : 0
+    height: window ? window.height : 0
+    color: "#fcfcfc"
+    border.color: "#3daee9"
+
+    Rectangle {
+        id: titleBar
+        width: parent.width
+        height: 32
+        color: "#dee0e2"
+    }
+
+    Column {
+        anchors.top: titleBar.bottom
+        anchors.left: parent.left
+        anchors.margins: 24
+        spacing: 12
+
+        Repeater {
+            model: 12
+
+            Rectangle {
+                width: thumbnail.width * (0.3 + 0.05 * (index % 7))
+                height: 14
+                radius: 3
+                color: index % 4 === 0 ? "#3daee9" : "#7f8c8d"
+            }
+        }
+    }
+}
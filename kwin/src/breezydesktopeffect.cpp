@@ -6,31 +6,46 @@
 #include "kcm/shortcuts.h"
 #include "breezydesktopeffect.h"
 #include "breezydesktopconfig.h"
+#include "breezydesktopnativerenderer.h"
+#include "breezydesktopoutputtextureitem.h"
+#include "breezydesktopscreentexturecache.h"
+#include "breezydesktoptrace.h"
+#include "breezydesktoptimewarp.h"
+#include "breezydesktopwindowfiltermodel.h"
 #include "effect/effect.h"
 #include "effect/effecthandler.h"
 #include "opengl/glutils.h"
 #include "xrdriveripc.h"
 
-#include <kwin/main.h>
-#include <core/outputbackend.h>
-
 #include <functional>
 #include <QAction>
 #include <QBuffer>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QFileSystemWatcher>
 #include <QJsonArray>
+#include <QJsonDocument>
 #include <QJsonObject>
 #include <QLoggingCategory>
+#include <QMatrix4x4>
+#include <QQmlComponent>
+#include <QQmlEngine>
 #include <QQuickItem>
 #include <QTimer>
+#include <QtMath>
+#include <QDBusArgument>
 #include <QDBusConnection>
 #include <QDateTime>
+#include <QElapsedTimer>
 
 #include <KGlobalAccel>
 #include <KLocalizedString>
 
 #include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <utility>
 
 Q_LOGGING_CATEGORY(KWIN_XR, "kwin.xr")
 
@@ -43,7 +58,20 @@ class BreezyDesktopDBusAdaptor : public QObject {
     Q_CLASSINFO("D-Bus Interface", "com.xronlinux.BreezyDesktop")
 public:
     explicit BreezyDesktopDBusAdaptor(KWin::BreezyDesktopEffect *effect)
-        : QObject(effect), m_effect(effect) {}
+        : QObject(effect), m_effect(effect)
+    {
+        // only runs while glasses are in use, nothing changes otherwise and KWin shouldn't be woken for it
+        m_statisticsTimer.setInterval(5000);
+        m_statisticsTimer.setTimerType(Qt::CoarseTimer);
+        connect(&m_statisticsTimer, &QTimer::timeout, this, [this]() {
+            Q_EMIT StatisticsUpdated(m_effect->statistics());
+        });
+        connect(effect, &KWin::BreezyDesktopEffect::enabledStateChanged, this, &BreezyDesktopDBusAdaptor::updateStatisticsTimer);
+        updateStatisticsTimer();
+    }
+
+Q_SIGNALS:
+    void StatisticsUpdated(const QVariantMap &statistics);
 
 public Q_SLOTS:
     QVariantList AddVirtualDisplay(int width, int height) {
@@ -51,6 +79,13 @@ public Q_SLOTS:
         return m_effect->listVirtualDisplays();
     }
 
+    // scale is KWin's output scale. textureUpdateRate caps how often the effect re-renders the display's texture (0 for
+    // on every damage), KWin still composites the virtual output itself at its one mode's rate.
+    QVariantList AddVirtualDisplayWithOptions(int width, int height, double scale, int textureUpdateRate) {
+        m_effect->addVirtualDisplay(QSize(width, height), scale, textureUpdateRate);
+        return m_effect->listVirtualDisplays();
+    }
+
     QVariantList ListVirtualDisplays() const {
         return m_effect->listVirtualDisplays();
     }
@@ -60,12 +95,61 @@ public Q_SLOTS:
         return m_effect->listVirtualDisplays();
     }
 
+    // Declarative batch: spec["displays"] is the complete list of wanted displays as a{sv} entries with width and
+    // height, and optionally id, x, y, scale and textureUpdateRate. Displays are matched by id, then by size; the rest
+    // are created, all positions applied in one configuration, and displays that aren't wanted anymore are removed.
+    QVariantList ApplyVirtualDisplays(const QVariantMap &spec) {
+        QList<QVariantMap> displays;
+        const QVariant value = spec.value(QStringLiteral("displays"));
+        if (value.canConvert<QDBusArgument>()) {
+            displays = qdbus_cast<QList<QVariantMap>>(value.value<QDBusArgument>());
+        } else {
+            const QVariantList list = value.toList();
+            for (const QVariant &entry : list) {
+                displays.append(entry.toMap());
+            }
+        }
+        m_effect->applyVirtualDisplays(displays);
+        return m_effect->listVirtualDisplays();
+    }
+
+    QStringList ListVirtualDisplayLayouts() const {
+        return m_effect->listVirtualDisplayLayouts();
+    }
+
+    bool SaveVirtualDisplayLayout(const QString &name) {
+        return m_effect->saveVirtualDisplayLayout(name);
+    }
+
+    QVariantList RestoreVirtualDisplayLayout(const QString &name) {
+        m_effect->restoreVirtualDisplayLayout(name);
+        return m_effect->listVirtualDisplays();
+    }
+
+    bool RemoveVirtualDisplayLayout(const QString &name) {
+        return m_effect->removeVirtualDisplayLayout(name);
+    }
+
     bool CurvedDisplaySupported() {
         return m_effect->curvedDisplaySupported();
     }
 
+    // counters and latency percentiles since the effect was loaded, see BreezyDesktopEffect::statistics()
+    QVariantMap GetStatistics() const {
+        return m_effect->statistics();
+    }
+
     private:
+        void updateStatisticsTimer() {
+            if (m_effect->isEnabled()) {
+                if (!m_statisticsTimer.isActive()) m_statisticsTimer.start();
+            } else {
+                m_statisticsTimer.stop();
+            }
+        }
+
         KWin::BreezyDesktopEffect *m_effect;
+        QTimer m_statisticsTimer;
     };
 } // namespace
 
@@ -108,6 +192,130 @@ namespace DataView
     constexpr int LENGTH = dataViewEnd(POSE_PARITY_BYTE);
 }
 
+namespace
+{
+    using namespace std::chrono_literals;
+
+    // motion samples further apart than this are treated as a new gesture, not a velocity
+    constexpr std::chrono::nanoseconds CURSOR_VELOCITY_MAX_INTERVAL = 100ms;
+
+    // never extrapolate the cursor further than this past its last motion event
+    constexpr std::chrono::nanoseconds CURSOR_PREDICTION_MAX_HORIZON = 50ms;
+
+    constexpr std::chrono::nanoseconds DEFAULT_FRAME_INTERVAL = 16667us;
+
+    // after smooth follow is disabled the driver slerps back to the origin, keep using the origin data until it's done
+    constexpr std::chrono::nanoseconds SMOOTH_FOLLOW_DISABLING_DURATION = 750ms;
+
+    // how often the developer mode statistics are logged and restarted
+    constexpr std::chrono::nanoseconds STATS_REPORT_INTERVAL = 5s;
+
+    // slow enough that refreshing the developer HUD doesn't show up in the frame times it displays
+    constexpr std::chrono::milliseconds HUD_UPDATE_INTERVAL = 1s;
+
+    // if rendering the scene takes more than this fraction of a frame, reproject the next frame instead
+    constexpr double TIMEWARP_SCENE_BUDGET_RATIO = 0.8;
+
+    // displays are culled against a frustum widened by this, plus how far the head can turn before the next frame
+    constexpr float CULLING_BASE_MARGIN_DEGREES = 5.0f;
+    constexpr int CULLING_MAX_DISPLAYS = 31;
+
+    // how far the predicted pose has to move, in pixels of the glasses' display, before a static scene is repainted
+    constexpr qreal REPAINT_POSE_THRESHOLD_PIXELS = 0.5;
+
+    QString installedQmlDirectory()
+    {
+        return QStandardPaths::locate(QStandardPaths::GenericDataLocation, QStringLiteral("kwin/effects/breezy_desktop/qml"),
+                                      QStandardPaths::LocateDirectory);
+    }
+
+    QUrl sceneSourceUrl()
+    {
+#ifdef BREEZY_DESKTOP_COMPILED_QML
+        // compiled into the plugin by qmlcachegen, see qt_add_qml_module in CMakeLists.txt
+        const QString compiledMainQml = QStringLiteral(":/qt/qml/org/kde/kwin/effect/breezy_desktop/scene/qml/main.qml");
+        if (QFile::exists(compiledMainQml)) return QUrl(QStringLiteral("qrc") + compiledMainQml);
+        qCWarning(KWIN_XR) << "\t\t\tBreezy - compiled QML not found, loading it from disk";
+#endif
+        return QUrl::fromLocalFile(installedQmlDirectory() + QStringLiteral("/main.qml"));
+    }
+
+    // Virtual display layouts live next to the KCM's custom resolutions: {"current": [...], "layouts": {name: [...]}},
+    // each display as {width, height, x, y, scale, textureUpdateRate}. "current" is restored after KWin restarts.
+    QString virtualDisplayLayoutsFilePath()
+    {
+        const QString fallback = QDir::homePath() + QStringLiteral("/.local/state");
+        const QString base = qEnvironmentVariable("XDG_STATE_HOME", fallback);
+        return QDir::cleanPath(base + QStringLiteral("/breezy_kwin/virtual_display_layouts.json"));
+    }
+
+    QJsonObject loadVirtualDisplayLayouts()
+    {
+        QFile f(virtualDisplayLayoutsFilePath());
+        if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) return {};
+        const QJsonDocument doc = QJsonDocument::fromJson(f.readAll());
+        return doc.isObject() ? doc.object() : QJsonObject();
+    }
+
+    void saveVirtualDisplayLayouts(const QJsonObject &layouts)
+    {
+        const QString path = virtualDisplayLayoutsFilePath();
+        QDir().mkpath(QFileInfo(path).absolutePath());
+        QFile f(path);
+        if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            qCWarning(KWIN_XR) << "\t\t\tBreezy - couldn't write" << path;
+            return;
+        }
+        f.write(QJsonDocument(layouts).toJson(QJsonDocument::Compact));
+    }
+
+    QJsonArray placementsToJson(const QList<KWin::BreezyDesktopVirtualOutputPool::Placement> &placements)
+    {
+        QJsonArray array;
+        for (const auto &placement : placements) {
+            QJsonObject entry;
+            entry.insert(QStringLiteral("width"), placement.size.width());
+            entry.insert(QStringLiteral("height"), placement.size.height());
+            const QPoint position = placement.position.value_or(QPoint());
+            entry.insert(QStringLiteral("x"), position.x());
+            entry.insert(QStringLiteral("y"), position.y());
+            entry.insert(QStringLiteral("scale"), placement.scale);
+            entry.insert(QStringLiteral("textureUpdateRate"), placement.textureUpdateRate);
+            array.append(entry);
+        }
+        return array;
+    }
+
+    QList<KWin::BreezyDesktopVirtualOutputPool::Placement> placementsFromJson(const QJsonArray &array)
+    {
+        QList<KWin::BreezyDesktopVirtualOutputPool::Placement> placements;
+        for (const QJsonValue &value : array) {
+            const QJsonObject entry = value.toObject();
+            KWin::BreezyDesktopVirtualOutputPool::Placement placement;
+            placement.size = QSize(entry.value(QStringLiteral("width")).toInt(), entry.value(QStringLiteral("height")).toInt());
+            if (placement.size.isEmpty()) continue;
+            placement.position = QPoint(entry.value(QStringLiteral("x")).toInt(), entry.value(QStringLiteral("y")).toInt());
+            placement.scale = entry.value(QStringLiteral("scale")).toDouble(1.0);
+            // saved as refreshRate before it was named for what it caps
+            placement.textureUpdateRate = entry.value(QStringLiteral("textureUpdateRate"))
+                .toInt(entry.value(QStringLiteral("refreshRate")).toInt());
+            placements.append(placement);
+        }
+        return placements;
+    }
+
+    std::chrono::nanoseconds steadyNow()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch());
+    }
+
+    qreal angularDistanceDegrees(const QQuaternion &a, const QQuaternion &b)
+    {
+        const float dot = std::clamp(std::abs(QQuaternion::dotProduct(a.normalized(), b.normalized())), 0.0f, 1.0f);
+        return qRadiansToDegrees(2.0 * std::acos(dot));
+    }
+}
+
 namespace KWin
 {
 
@@ -121,19 +329,95 @@ BreezyDesktopEffect::BreezyDesktopEffect()
     }
 
     qCCritical(KWIN_XR) << "\t\t\tBreezy - constructor";
+    QElapsedTimer constructorTimer;
+    constructorTimer.start();
 
-    // safe to request on each load, acts as a no-op if already present
-    {
-        QJsonObject flags;
-        QJsonArray requested;
-        requested.append(QStringLiteral("productivity"));
-        requested.append(QStringLiteral("productivity_pro"));
-        flags.insert(QStringLiteral("request_features"), requested);
-        XRDriverIPC::instance().writeControlFlags(flags);
-    }
-    
+    // This runs while KWin starts up, on every login whether glasses are attached or not, so it only does what's
+    // needed to notice the glasses and to answer the KCM. Shortcuts are registered once the event loop is idle, the
+    // rest waits for the driver's IMU file, see initializeDeferred().
     qmlRegisterUncreatableType<BreezyDesktopEffect>("org.kde.kwin.effect.breezy_desktop", 1, 0, "BreezyDesktopEffect", QStringLiteral("BreezyDesktop cannot be created in QML"));
+    qmlRegisterType<BreezyDesktopWindowFilterModel>("org.kde.kwin.effect.breezy_desktop", 1, 0, "WindowFilterModel");
+    qmlRegisterType<BreezyDesktopOutputTextureItem>("org.kde.kwin.effect.breezy_desktop", 1, 0, "OutputTexture");
+
+    QTimer::singleShot(0, this, &BreezyDesktopEffect::registerShortcuts);
+
+    // mirrors CameraController.qml's smoothFollowDisablingTimer for the late-latched pose
+    connect(this, &BreezyDesktopEffect::smoothFollowEnabledChanged, this, [this]() {
+        m_smoothFollowDisablingUntil = m_focusedSmoothFollowEnabled ?
+            std::chrono::nanoseconds::zero() :
+            steadyNow() + SMOOTH_FOLLOW_DISABLING_DURATION;
+    });
+
+    const auto countOutputLayoutChange = [this]() { ++m_outputLayoutChanges; };
+    connect(effects, &EffectsHandler::screenAdded, this, countOutputLayoutChange);
+    connect(effects, &EffectsHandler::screenRemoved, this, countOutputLayoutChange);
+    connect(effects, &EffectsHandler::virtualScreenGeometryChanged, this, countOutputLayoutChange);
+
+    m_hudTimer = new QTimer(this);
+    m_hudTimer->setInterval(HUD_UPDATE_INTERVAL);
+    m_hudTimer->setTimerType(Qt::CoarseTimer);
+    connect(m_hudTimer, &QTimer::timeout, this, &BreezyDesktopEffect::updateHudStatistics);
+    connect(this, &BreezyDesktopEffect::developerModeChanged, this, &BreezyDesktopEffect::updateHudTimer);
+    connect(this, &BreezyDesktopEffect::enabledStateChanged, this, &BreezyDesktopEffect::updateHudTimer);
+
+    reconfigure(ReconfigureAll);
+
+    // only records the URL, the QML is compiled on activation or by prewarmScene()
+    m_sceneSource = sceneSourceUrl();
+    setSource(m_sceneSource);
+
+    // Monitor the IPC file for changes, even if it doesn't exist at startup
+    m_shmDirectoryWatcher = new QFileSystemWatcher(this);
+    m_shmDirectoryWatcher->addPath(DataView::SHM_DIR);
+
+    m_shmFileWatcher = new QFileSystemWatcher(this);
+
+    // Setup file watcher with recreation detection
+    auto setupFileWatcher = [this]() {
+        if (QFile::exists(DataView::SHM_PATH)) initializeDeferred();
+        if (QFile::exists(DataView::SHM_PATH) && (
+            m_poseTimestamp == 0 || 
+            QDateTime::currentMSecsSinceEpoch() - m_poseTimestamp > 50 || // file may have been deleted and recreated
+            !m_shmFileWatcher->files().contains(DataView::SHM_PATH)
+        )) {
+            m_shmFileWatcher->removePath(DataView::SHM_PATH);
+            disconnect(m_shmFileWatcher, &QFileSystemWatcher::fileChanged, this, &BreezyDesktopEffect::updatePose);
+            m_shmFileWatcher->addPath(DataView::SHM_PATH);
+            connect(m_shmFileWatcher, &QFileSystemWatcher::fileChanged, this, &BreezyDesktopEffect::updatePose);
+        }
+    };
 
+    // Handle directory changes (file creation/recreation)
+    connect(m_shmDirectoryWatcher, &QFileSystemWatcher::directoryChanged, this, setupFileWatcher);
+
+    // Initial setup
+    setupFileWatcher();
+
+    m_watchdogTimer = new QTimer(this);
+    m_watchdogTimer->setInterval(1000);
+    connect(m_watchdogTimer, &QTimer::timeout, this, [this]() {
+        if (!m_enabled) return;
+        this->updatePose();
+    });
+    m_watchdogTimer->start();
+
+    // Register DBus object under KWin's session bus name
+    auto *adaptor = new BreezyDesktopDBusAdaptor(this);
+    const bool dbusOk = QDBusConnection::sessionBus().registerObject(
+        QStringLiteral("/com/xronlinux/BreezyDesktop"),
+        adaptor,
+        QDBusConnection::ExportAllSlots | QDBusConnection::ExportAllSignals);
+    if (!dbusOk) {
+        qCWarning(KWIN_XR) << "Failed to register DBus object /com/xronlinux/BreezyDesktop";
+    }
+
+    qCInfo(KWIN_XR) << "\t\t\tBreezy - constructor took" << constructorTimer.elapsed() << "ms"
+                    << (m_deferredInitialized ? "(IMU file present, deferred initialization included)" : "");
+}
+
+void BreezyDesktopEffect::registerShortcuts()
+{
+    // each one is a round trip to kglobalaccel
     setupGlobalShortcut(
         BreezyShortcuts::TOGGLE,
         [this]() { this->toggle(); }
@@ -156,159 +440,1018 @@ BreezyDesktopEffect::BreezyDesktopEffect()
         BreezyShortcuts::CURSOR_TO_FOCUSED_DISPLAY,
         [this]() { this->moveCursorToFocusedDisplay(); }
     );
+}
+
+void BreezyDesktopEffect::initializeDeferred()
+{
+    if (m_deferredInitialized) return;
+    m_deferredInitialized = true;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Safe to request on each load, acts as a no-op if already present. It spawns python and can block for up to
+    // 15s, so it runs on the effect's own pool thread; XRDriverIPC's calls are stateless once instance() has been set
+    // up here.
+    XRDriverIPC &ipc = XRDriverIPC::instance();
+    ipc.setCallObserver([this](const QString &, double durationMs, bool succeeded) {
+        m_statistics.ipcCalls.add();
+        if (!succeeded) m_statistics.ipcFailures.add();
+        m_statistics.ipcLatency.add(durationMs);
+    });
+    m_ipcThreadPool.start([&ipc]() {
+        BREEZY_TRACE_SCOPE("ipc: request features");
+        QJsonObject flags;
+        QJsonArray requested;
+        requested.append(QStringLiteral("productivity"));
+        requested.append(QStringLiteral("productivity_pro"));
+        flags.insert(QStringLiteral("request_features"), requested);
+        ipc.writeControlFlags(flags);
+    });
 
     connect(effects, &EffectsHandler::cursorShapeChanged, this, &BreezyDesktopEffect::updateCursorImage);
     updateCursorImage();
-    reconfigure(ReconfigureAll);
 
-    setSource(QUrl::fromLocalFile(QStandardPaths::locate(QStandardPaths::GenericDataLocation, QStringLiteral("kwin/effects/breezy_desktop/qml/main.qml"))));
+    if (BreezyDesktopConfig::prewarmScene()) QTimer::singleShot(0, this, &BreezyDesktopEffect::prewarmScene);
+
+    qCInfo(KWIN_XR) << "\t\t\tBreezy - deferred initialization took" << timer.elapsed() << "ms";
+}
+
+BreezyDesktopEffect::~BreezyDesktopEffect()
+{
+    qCCritical(KWIN_XR) << "\t\t\tBreezy - destructor";
+    if (m_shmFileWatcher) {
+        if (!DataView::SHM_PATH.isEmpty()) {
+            m_shmFileWatcher->removePath(DataView::SHM_PATH);
+        }
+        m_shmFileWatcher->deleteLater();
+        m_shmFileWatcher = nullptr;
+    }
+    if (m_shmDirectoryWatcher) {
+        m_shmDirectoryWatcher->deleteLater();
+        m_shmDirectoryWatcher = nullptr;
+    }
+    if (m_watchdogTimer) {
+        m_watchdogTimer->stop();
+        m_watchdogTimer->deleteLater();
+        m_watchdogTimer = nullptr;
+    }
+    deactivate();
+
+    // the driver IPC singleton outlives the effect: once the observer is cleared no running call can reach
+    // m_statistics, then wait for the pool so no task is left running against a plugin that's being unloaded
+    if (m_deferredInitialized) XRDriverIPC::instance().setCallObserver({});
+    m_ipcThreadPool.waitForDone();
+
+    // parked outputs shouldn't outlive the effect
+    m_virtualOutputs.clear();
+}
+
+void BreezyDesktopEffect::prewarmScene()
+{
+    // Compiling main.qml resolves everything it references (BreezyDesktop.qml, Displays.qml, QtQuick3D's plugin...)
+    // into the engine's type cache, which the scene instantiated on activation then reuses. Instantiating it here
+    // would need the target screen and a GPU context, so that still happens in activate().
+    const std::chrono::nanoseconds start = steadyNow();
+    m_prewarmComponent = std::make_unique<QQmlComponent>(effects->qmlEngine(), m_sceneSource, QQmlComponent::Asynchronous);
+    const auto report = [this, start]() {
+        if (m_prewarmComponent->isLoading()) return;
+
+        m_scenePrewarmed = m_prewarmComponent->isReady();
+        if (m_prewarmComponent->isError()) {
+            qCWarning(KWIN_XR) << "\t\t\tBreezy - scene prewarm failed:" << m_prewarmComponent->errorString();
+        } else if (m_developerMode) {
+            qCInfo(KWIN_XR) << "\t\t\tBreezy - scene prewarm: QML compiled in"
+                            << std::chrono::duration<double, std::milli>(steadyNow() - start).count() << "ms";
+        }
+    };
+    if (m_prewarmComponent->isLoading()) {
+        connect(m_prewarmComponent.get(), &QQmlComponent::statusChanged, this, report);
+    } else {
+        report();
+    }
+}
+
+QUrl BreezyDesktopEffect::assetsUrl() const
+{
+    // banner images are dropped next to the installed QML, even when the QML itself is compiled in
+    return QUrl::fromLocalFile(installedQmlDirectory() + QLatin1Char('/'));
+}
+
+void BreezyDesktopEffect::setupGlobalShortcut(const BreezyShortcuts::Shortcut &shortcut, std::function<void()> triggeredFunc) {
+    QAction *action = new QAction(this);
+    action->setObjectName(shortcut.actionName);
+    action->setText(shortcut.actionText);
+    KGlobalAccel::self()->setDefaultShortcut(action, {shortcut.shortcut});
+    KGlobalAccel::self()->setShortcut(action, {shortcut.shortcut});
+    connect(action, &QAction::triggered, this, triggeredFunc);
+}
+
+void BreezyDesktopEffect::recenter() {
+    BREEZY_TRACE_SCOPE("ipc: recenter");
+    QJsonObject flags; 
+    flags.insert(QStringLiteral("recenter_screen"), true);
+    XRDriverIPC::instance().writeControlFlags(flags);
+}
+
+void BreezyDesktopEffect::setLookingAtScreenIndex(int index)
+{
+    m_lookingAtScreenIndex = index;
+    if (m_smoothFollowEnabled) updateDriverSmoothFollowSettings();
+}
+
+void BreezyDesktopEffect::reconfigure(ReconfigureFlags)
+{
+    BreezyDesktopConfig::self()->read();
+    setLookAheadOverride(BreezyDesktopConfig::lookAheadOverride());
+    setFocusedDisplayDistance(BreezyDesktopConfig::focusedDisplayDistance() / 100.0f);
+    setAllDisplaysDistance(BreezyDesktopConfig::allDisplaysDistance() / 100.0f);
+    setDisplaySpacing(BreezyDesktopConfig::displaySpacing() / 1000.0f);
+    setDisplaySize(BreezyDesktopConfig::displaySize() / 100.0f);
+    setZoomOnFocusEnabled(BreezyDesktopConfig::zoomOnFocusEnabled());
+    setSmoothFollowThreshold(BreezyDesktopConfig::smoothFollowThreshold());
+
+    qreal horiz = BreezyDesktopConfig::displayHorizontalOffset() / 100.0f;
+    qreal vert = BreezyDesktopConfig::displayVerticalOffset() / 100.0f;
+    bool offsetchanged = false;
+    if (!qFuzzyCompare(m_displayHorizontalOffset, horiz)) { m_displayHorizontalOffset = horiz; offsetchanged = true; }
+    if (!qFuzzyCompare(m_displayVerticalOffset, vert)) { m_displayVerticalOffset = vert; offsetchanged = true; }
+    if (offsetchanged) Q_EMIT displayOffsetChanged();
+
+    int wrap = BreezyDesktopConfig::displayWrappingScheme();
+    int aaQuality = BreezyDesktopConfig::antialiasingQuality();
+    bool removeVD = BreezyDesktopConfig::removeVirtualDisplaysOnDisable();
+    bool mirrorPhysicalDisplays = BreezyDesktopConfig::mirrorPhysicalDisplays();
+    if (m_displayWrappingScheme != wrap) { m_displayWrappingScheme = wrap; Q_EMIT displayWrappingSchemeChanged(); }
+    if (m_antialiasingQuality != aaQuality) {
+        m_antialiasingQuality = aaQuality;
+        m_qualityGovernor.reset();
+        const BreezyDesktopQualityGovernor::Level quality = autoQualityActive() ? m_qualityGovernor.level() : BreezyDesktopQualityGovernor::Level{aaQuality, 1.0};
+        if (quality.antialiasingQuality != m_renderQuality.antialiasingQuality || quality.renderScale != m_renderQuality.renderScale) {
+            m_renderQuality = quality;
+            Q_EMIT renderQualityChanged();
+        }
+        Q_EMIT antialiasingQualityChanged();
+    }
+    if (m_removeVirtualDisplaysOnDisable != removeVD) { m_removeVirtualDisplaysOnDisable = removeVD; Q_EMIT removeVirtualDisplaysOnDisableChanged(); }
+    if (m_mirrorPhysicalDisplays != mirrorPhysicalDisplays) { m_mirrorPhysicalDisplays = mirrorPhysicalDisplays; Q_EMIT mirrorPhysicalDisplaysChanged(); }
+
+    const bool developerMode = BreezyDesktopConfig::developerMode();
+    if (m_developerMode != developerMode) { m_developerMode = developerMode; Q_EMIT developerModeChanged(); }
+
+    const bool lateLatchPose = BreezyDesktopConfig::lateLatchPose();
+    if (m_lateLatchPose != lateLatchPose) {
+        m_lateLatchPose = lateLatchPose;
+        m_poseAgeAtSubmit.reset();
+        m_applyToSubmit.reset();
+        Q_EMIT lateLatchPoseChanged();
+    }
+
+    m_timewarpEnabled = BreezyDesktopConfig::timewarp();
+    m_timewarpSceneFrameDivider = BreezyDesktopConfig::timewarpSceneFrameDivider();
+
+    m_displayCulling = BreezyDesktopConfig::displayCulling();
+    if (!m_displayCulling && m_culledDisplayMask != 0) {
+        m_culledDisplayMask = 0;
+        Q_EMIT culledDisplayMaskChanged();
+    }
+
+    const bool focusLodEnabled = BreezyDesktopConfig::focusLod();
+    const qreal unfocusedTextureScale = BreezyDesktopConfig::unfocusedTextureScale() / 100.0;
+    const bool distanceTextureScaling = BreezyDesktopConfig::distanceTextureScaling();
+    if (m_focusLodEnabled != focusLodEnabled || !qFuzzyCompare(m_unfocusedTextureScale, unfocusedTextureScale) ||
+        m_distanceTextureScaling != distanceTextureScaling) {
+        m_focusLodEnabled = focusLodEnabled;
+        m_unfocusedTextureScale = unfocusedTextureScale;
+        m_distanceTextureScaling = distanceTextureScaling;
+        m_paintTime.reset();
+        Q_EMIT focusLodChanged();
+    }
+
+    const bool repaintSuppression = BreezyDesktopConfig::staticPoseRepaintSuppression();
+    if (m_repaintSuppression != repaintSuppression) {
+        m_repaintSuppression = repaintSuppression;
+        if (updateEffectOnScreenGeometryCache()) effects->addRepaint(m_effectOnScreenGeometry);
+    }
+
+    const int renderBackend = BreezyDesktopConfig::renderBackend();
+    if (m_renderBackend != renderBackend) {
+        m_renderBackend = renderBackend;
+        m_paintTime.reset();
+        m_culledDisplays.reset();
+        Q_EMIT renderBackendChanged();
+    }
+
+    const int displayTextureSource = BreezyDesktopConfig::displayTextureSource();
+    if (m_displayTextureSource != displayTextureSource) {
+        m_displayTextureSource = displayTextureSource;
+        m_paintTime.reset();
+        if (m_screenTextures) m_screenTextures->renderTime().reset();
+        Q_EMIT displayTextureSourceChanged();
+        Q_EMIT instancedDisplaysChanged();
+    }
+
+    const bool instancedDisplays = BreezyDesktopConfig::instancedDisplays();
+    if (m_instancedDisplays != instancedDisplays) {
+        m_instancedDisplays = instancedDisplays;
+        m_paintTime.reset();
+        Q_EMIT instancedDisplaysChanged();
+    }
+
+    bool curved = BreezyDesktopConfig::curvedDisplay() && m_curvedDisplaySupported;
+    if (m_curvedDisplay != curved) { m_curvedDisplay = curved; Q_EMIT curvedDisplayChanged(); }
+
+    // this one doesn't have a signal, just always assign it
+    m_allDisplaysFollowMode = BreezyDesktopConfig::allDisplaysFollowMode();
+}
+
+bool BreezyDesktopEffect::developerMode() const
+{
+    return m_developerMode;
+}
+
+bool BreezyDesktopEffect::lateLatchPose() const
+{
+    return m_lateLatchPose;
+}
+
+int BreezyDesktopEffect::culledDisplayMask() const
+{
+    return m_culledDisplayMask;
+}
+
+bool BreezyDesktopEffect::focusLodEnabled() const
+{
+    return m_focusLodEnabled;
+}
+
+qreal BreezyDesktopEffect::unfocusedTextureScale() const
+{
+    return m_unfocusedTextureScale;
+}
+
+bool BreezyDesktopEffect::distanceTextureScaling() const
+{
+    return m_distanceTextureScaling;
+}
+
+bool BreezyDesktopEffect::animationsActive() const
+{
+    return m_animationsActive;
+}
+
+void BreezyDesktopEffect::setAnimationsActive(bool active)
+{
+    if (m_animationsActive == active) return;
+    m_animationsActive = active;
+    if (m_animationsActive && updateEffectOnScreenGeometryCache()) effects->addRepaint(m_effectOnScreenGeometry);
+    Q_EMIT animationsActiveChanged();
+}
+
+bool BreezyDesktopEffect::instancedDisplays() const
+{
+    // the atlas is built from the output textures
+    return m_instancedDisplays && displayTextureSource() == 1;
+}
+
+bool BreezyDesktopEffect::instancedDisplaysActive() const
+{
+    return m_instancedDisplaysActive;
+}
+
+void BreezyDesktopEffect::setInstancedDisplaysActive(bool active)
+{
+    if (m_instancedDisplaysActive == active) return;
+    m_instancedDisplaysActive = active;
+    m_paintTime.reset();
+    Q_EMIT instancedDisplaysActiveChanged();
+}
+
+int BreezyDesktopEffect::displayTextureSource() const
+{
+    // output textures are rendered with KWin's GL helpers, thumbnails are the only option without OpenGL compositing
+    return m_displayTextureSource == 1 && effects->isOpenGLCompositing() ? 1 : 0;
+}
+
+QVariantMap BreezyDesktopEffect::textureUpdateRates() const
+{
+    return m_textureUpdateRates;
+}
+
+QObject *BreezyDesktopEffect::screenTextures() const
+{
+    return m_screenTextures.get();
+}
+
+int BreezyDesktopEffect::renderBackend() const
+{
+    // the native backend needs OpenGL compositing, QML falls back to the QtQuick3D scene without it
+    return nativeBackendActive() ? 1 : 0;
+}
+
+QVector3D BreezyDesktopEffect::cameraEulerRotation() const
+{
+    return m_cameraEulerRotation;
+}
+
+QQuaternion BreezyDesktopEffect::cameraOrientation() const
+{
+    return m_cameraOrientation;
+}
+
+QVector3D BreezyDesktopEffect::cameraAngularRates() const
+{
+    return m_cameraAngularRates;
+}
+
+QVariantMap BreezyDesktopEffect::initialProperties(ScreenOutput *screen)
+{
+    return QVariantMap{
+        {QStringLiteral("effect"), QVariant::fromValue(this)},
+        {QStringLiteral("targetScreen"), QVariant::fromValue(screen)}
+    };
+}
+
+int BreezyDesktopEffect::requestedEffectChainPosition() const
+{
+    return 70;
+}
+
+void BreezyDesktopEffect::prePaintScreen(ScreenPrePaintData &data, std::chrono::milliseconds presentTime)
+{
+    BREEZY_TRACE_SCOPE("prePaintScreen");
+    const std::chrono::nanoseconds prePaintStart = steadyNow();
+    if (m_cursorUpdatePending) {
+        m_cursorUpdatePending = false;
+
+        // predict where the cursor will be when the frame after this one is presented
+        std::chrono::nanoseconds frameInterval = DEFAULT_FRAME_INTERVAL;
+        if (data.screen && data.screen->refreshRate() > 0) {
+            frameInterval = std::chrono::nanoseconds(1'000'000'000'000LL / data.screen->refreshRate());
+        }
+        updateCursorPos(presentTime + frameInterval);
+    }
+
+    m_paintingEffectScreen = m_enabled && updateEffectOnScreenGeometryCache() &&
+        data.screen && data.screen->geometry() == m_effectOnScreenGeometry;
+    if (m_paintingEffectScreen) {
+        m_frameInterval = data.screen->refreshRate() > 0 ?
+            std::chrono::nanoseconds(1'000'000'000'000LL / data.screen->refreshRate()) :
+            DEFAULT_FRAME_INTERVAL;
+        m_lastPresentTime = m_presentTime;
+        m_presentTime = presentTime;
+        m_frameStart = prePaintStart;
+    }
+
+    // the scene is polished and rendered after this, so this is the last chance to hand it a fresher pose
+    if (m_paintingEffectScreen && (m_lateLatchPose || nativeBackendActive() || m_displayCulling) && latchCameraPose()) {
+        BREEZY_TRACE_SCOPE("apply camera pose");
+        Q_EMIT cameraPoseLatched();
+        if (m_displayCulling) updateDisplayCulling();
+        if (m_lateLatchPose || nativeBackendActive()) {
+            m_appliedPoseTimestamp = m_poseTimestamp;
+            m_cameraAppliedAt = steadyNow();
+            m_renderedCameraRotation = QQuaternion::fromEulerAngles(m_cameraEulerRotation);
+            m_renderedCameraPosition = cameraPosition();
+            m_renderedPoseValid = true;
+        }
+
+        // the newest sample approximates where the head actually was when the previous frame was presented
+        if (m_timewarpPresentedValid) {
+            m_timewarpResidualError.add(angularDistanceDegrees(m_timewarpPresentedOrientation, m_cameraOrientation));
+            m_timewarpStaleError.add(angularDistanceDegrees(m_timewarpRenderedOrientation, m_cameraOrientation));
+            m_timewarpPresentedValid = false;
+        }
+    }
+
+    if (m_paintingEffectScreen && m_screenTextures) {
+        if (nativeBackendActive()) m_screenTextures->takeDamagedScreens();
+        else updateDisplayTextures();
+    }
+
+    // QuickSceneEffect::prePaintScreen is where the view is polished and rendered before it passes the call down the
+    // effect chain, paintScreen only draws the view's texture. So a frame is reprojected by skipping the base class and
+    // passing the call down directly: the view stays dirty until the next scene frame, paintTimewarp() re-rotates the
+    // last one, and the effects after this one and the compositor still get their pre-paint.
+    m_timewarpReprojecting = false;
+    const bool timewarpFrame = m_paintingEffectScreen && timewarpActive() && !m_poseResetState;
+    if (timewarpFrame) {
+        // the divider forces scene frame drops so the reprojection can be evaluated in isolation
+        ++m_timewarpFrameCount;
+        ++m_timewarpFrames;
+        const bool forcedDrop = m_timewarpSceneFrameDivider > 1 && (m_timewarpFrameCount % m_timewarpSceneFrameDivider) != 0;
+        const QSize textureSize = (QSizeF(data.screen->geometry().size()) * data.screen->scale()).toSize();
+        m_timewarpReprojecting = m_timewarp && m_timewarp->hasFrame(textureSize) && (forcedDrop || m_timewarpSkipNextScene);
+        m_timewarpSkipNextScene = false;
+    }
+    if (m_timewarpReprojecting) {
+        ++m_timewarpReprojectedFrames;
+        effects->prePaintScreen(data, presentTime);
+        return;
+    }
+
+    const std::chrono::nanoseconds sceneStart = steadyNow();
+    QuickSceneEffect::prePaintScreen(data, presentTime);
+    if (timewarpFrame) {
+        // Only the CPU side of the render is visible here, GPU time isn't measured. Reprojection runs synchronously in
+        // the compositor's paint, so a skipped scene frame saves this time in the same frame rather than overlapping it.
+        m_lastSceneRenderCost = steadyNow() - sceneStart;
+        m_timewarpSkipNextScene = m_lastSceneRenderCost.count() > m_frameInterval.count() * TIMEWARP_SCENE_BUDGET_RATIO;
+    }
+}
+
+bool BreezyDesktopEffect::timewarpActive() const
+{
+    // reprojecting a side-by-side frame would drag one eye's image into the other
+    return m_timewarpEnabled && m_lateLatchPose && !m_sbsEnabled && effects->isOpenGLCompositing();
+}
+
+QVector2D BreezyDesktopEffect::fovHalfTangents() const
+{
+    // same as Displays.qml's diagonalToCrossFOVs
+    if (m_displayResolution.size() < 2 || m_displayResolution[1] == 0) return QVector2D();
+    const qreal aspectRatio = static_cast<qreal>(m_displayResolution[0]) / m_displayResolution[1];
+    const qreal diagonalLengthUnitDistance = 2.0 * std::tan(qDegreesToRadians(m_diagonalFOV) / 2.0);
+    const qreal heightUnitDistance = diagonalLengthUnitDistance / std::sqrt(1.0 + aspectRatio * aspectRatio);
+    const qreal widthUnitDistance = heightUnitDistance * aspectRatio;
+    return QVector2D(widthUnitDistance / 2.0, heightUnitDistance / 2.0);
+}
+
+bool BreezyDesktopEffect::nativeBackendActive() const
+{
+    return m_renderBackend == 1 && effects->isOpenGLCompositing();
+}
+
+void BreezyDesktopEffect::paintScreen(const RenderTarget &renderTarget, const RenderViewport &viewport, int mask, const PaintRegion &region, ScreenOutput *screen)
+{
+    BREEZY_TRACE_SCOPE("paintScreen");
+    if (!m_paintingEffectScreen) {
+        QuickSceneEffect::paintScreen(renderTarget, viewport, mask, region, screen);
+        return;
+    }
+
+    // during a pose reset main.qml keeps the XR scene loaded but hidden behind the flat desktop and banner,
+    // which is all there is to draw
+    if (nativeBackendActive() && !m_poseResetState) {
+        if (!paintNative(viewport)) QuickSceneEffect::paintScreen(renderTarget, viewport, mask, region, screen);
+    } else if (timewarpActive() && !m_poseResetState) {
+        paintTimewarp(renderTarget, viewport, mask, region, screen);
+    } else {
+        QuickSceneEffect::paintScreen(renderTarget, viewport, mask, region, screen);
+    }
+
+    if (m_firstFrameAfterPoseResetPending && !m_poseResetState) {
+        m_firstFrameAfterPoseResetPending = false;
+        const double firstFrameMs = std::chrono::duration<double, std::milli>(steadyNow() - m_poseResetEndedAt).count();
+        m_firstFrameAfterPoseReset.add(firstFrameMs);
+        if (m_developerMode) {
+            qCInfo(KWIN_XR) << "\t\t\tBreezy - first XR frame after pose reset:" << firstFrameMs << "ms;"
+                            << "avg" << m_firstFrameAfterPoseReset.average() << "ms,"
+                            << "max" << m_firstFrameAfterPoseReset.max << "ms over" << m_firstFrameAfterPoseReset.count << "resets";
+        }
+    }
+
+    if (m_firstFrameAfterActivationPending && !m_poseResetState) {
+        m_firstFrameAfterActivationPending = false;
+        if (m_developerMode) {
+            qCInfo(KWIN_XR) << "\t\t\tBreezy - activation: first XR frame after"
+                            << std::chrono::duration<double, std::milli>(steadyNow() - m_activatedAt).count() << "ms,"
+                            << "scene instantiation" << m_sceneInstantiationMs << "ms;"
+                            << (m_scenePrewarmed ? "QML prewarmed" : "QML not prewarmed")
+                            << (m_sceneSource.scheme() == QLatin1String("qrc") ? "(compiled)" : "(from disk)")
+                            << "; output layout changes since deactivation:"
+                            << m_outputLayoutChanges - m_outputLayoutChangesAtDeactivate;
+        }
+    }
+}
+
+bool BreezyDesktopEffect::paintNative(const RenderViewport &viewport)
+{
+    if (!m_nativeRenderer || !m_screenTextures) return false;
+
+    // camera, same as CameraController.qml's updateCameraPosition and buildPerspectiveMatrix
+    const QVector2D tangents = fovHalfTangents();
+    if (tangents.isNull()) return false;
+
+    QMatrix4x4 cameraTransform;
+    cameraTransform.translate(cameraPosition());
+    cameraTransform.rotate(QQuaternion::fromEulerAngles(m_cameraEulerRotation));
+
+    constexpr float clipNear = 10.0f;
+    constexpr float clipFar = 10000.0f;
+    const float f = 1.0f / tangents.y();
+    const float aspectRatio = tangents.x() / tangents.y();
+    const float nf = 1.0f / (clipNear - clipFar);
+    const QMatrix4x4 projection(
+        f / aspectRatio, 0, 0, 0,
+        0, f, 0, 0,
+        0, 0, (clipFar + clipNear) * nf, (2.0f * clipFar * clipNear) * nf,
+        0, 0, -1, 0);
+
+    BreezyDesktopNativeRenderer::Cursor cursor;
+    cursor.image = m_cursorImage;
+    cursor.rect = QRectF(m_cursorPos, QSizeF(m_cursorImageSize));
+
+    return m_nativeRenderer->paint(viewport, projection * cameraTransform.inverted(), *m_screenTextures, cursor, m_culledDisplayMask);
+}
+
+QVector3D BreezyDesktopEffect::cameraPosition() const
+{
+    return cameraPosition(m_cameraOrientation);
+}
+
+QVector3D BreezyDesktopEffect::cameraPosition(const QQuaternion &orientation) const
+{
+    // same as CameraController.qml's updateCameraPosition
+    QVector3D lensVector(0, 0, -m_cameraLensDistancePixels);
+    if (!m_poseHasPosition) lensVector = orientation.rotatedVector(lensVector);
+    return m_posePosition * m_cameraFullScreenDistancePixels + lensVector;
+}
+
+void BreezyDesktopEffect::setCameraDistances(qreal lensDistancePixels, qreal fullScreenDistancePixels)
+{
+    m_cameraLensDistancePixels = lensDistancePixels;
+    m_cameraFullScreenDistancePixels = fullScreenDistancePixels;
+}
+
+void BreezyDesktopEffect::setDisplayBounds(int index, const QVector3D &center, qreal radius)
+{
+    if (index < 0) return;
+    if (index >= m_displayBounds.size()) {
+        if (radius < 0) return;
+        m_displayBounds.resize(index + 1);
+    }
+    m_displayBounds[index] = {center, radius};
+}
+
+void BreezyDesktopEffect::setDisplayMeshStats(int index, int vertexCount, qreal errorPixels)
+{
+    if (index < 0) return;
+    if (index >= m_displayMeshStats.size()) {
+        if (vertexCount < 0) return;
+        m_displayMeshStats.resize(index + 1);
+    }
+    m_displayMeshStats[index] = {vertexCount, errorPixels};
+}
+
+void BreezyDesktopEffect::setDisplayPixelBudget(int index, qreal fullPixels, qreal renderedPixels, qreal visiblePixels)
+{
+    if (index < 0) return;
+    if (index >= m_displayPixelBudgets.size()) {
+        if (fullPixels < 0) return;
+        m_displayPixelBudgets.resize(index + 1);
+    }
+    m_displayPixelBudgets[index] = {fullPixels, renderedPixels, visiblePixels};
+}
+
+void BreezyDesktopEffect::updateDisplayCulling()
+{
+    const QVector2D tangents = fovHalfTangents();
+    if (tangents.isNull()) return;
+
+    // widen the frustum by how far the head can turn before the next pose is latched, so displays are
+    // already rendered (and their textures up to date) by the time they come into view
+    const float horizonMs = static_cast<float>(
+        (m_lookAheadOverride == -1 && !m_lookAheadConfig.isEmpty() ? m_lookAheadConfig[0] : m_lookAheadOverride) +
+        std::chrono::duration<double, std::milli>(m_frameInterval).count());
+    const float marginRadians = qDegreesToRadians(CULLING_BASE_MARGIN_DEGREES) + m_cameraAngularRates.length() * std::max(horizonMs, 0.0f);
+    const auto widen = [marginRadians](float tangent) {
+        return std::tan(std::min(std::atan(tangent) + marginRadians, qDegreesToRadians(89.0f)));
+    };
+    const float tanX = widen(tangents.x());
+    const float tanY = widen(tangents.y());
+    const float normX = std::sqrt(1.0f + tanX * tanX);
+    const float normY = std::sqrt(1.0f + tanY * tanY);
+
+    const QQuaternion inverseRotation = QQuaternion::fromEulerAngles(m_cameraEulerRotation).conjugated();
+    const QVector3D position = cameraPosition();
+
+    int mask = 0;
+    int culledCount = 0;
+    const int count = std::min<int>(m_displayBounds.size(), CULLING_MAX_DISPLAYS);
+    for (int i = 0; i < count; ++i) {
+        const DisplayBounds &bounds = m_displayBounds.at(i);
+        if (bounds.radius < 0) continue;
+
+        // camera space, looking down -z
+        const QVector3D p = inverseRotation.rotatedVector(bounds.center - position);
+        const float r = bounds.radius;
+        const bool culled =
+            p.z() > r ||
+            (p.x() + tanX * p.z()) / normX > r ||
+            (-p.x() + tanX * p.z()) / normX > r ||
+            (p.y() + tanY * p.z()) / normY > r ||
+            (-p.y() + tanY * p.z()) / normY > r;
+        if (culled) {
+            mask |= (1 << i);
+            ++culledCount;
+        }
+    }
+    m_culledDisplays.add(culledCount);
+
+    if (m_culledDisplayMask != mask) {
+        m_culledDisplayMask = mask;
+        Q_EMIT culledDisplayMaskChanged();
+    }
+}
+
+void BreezyDesktopEffect::updateDisplayTextures()
+{
+    if (displayTextureSource() == 1) {
+        // OutputTexture items sample these from the scene, they need to be current before it renders
+        m_screenTextures->takeDamagedScreens();
+        const int updated = m_screenTextures->updateAcquired();
+        m_displayTextureUpdates += updated;
+        m_displayTextureUpdatesSkipped += std::max(0, m_screenTextures->acquiredCount() - updated);
+        return;
+    }
+
+    // window thumbnail displays only re-render their layer when told to, see BreezyDesktopDisplay.qml
+    // thumbnails re-render their own offscreen textures on the damage too, which can land a frame after ours,
+    // so damaged screens get a second update on the following frame
+    const QSet<ScreenOutput *> newlyDamaged = m_screenTextures->takeDamagedScreens();
+    const QSet<ScreenOutput *> damaged = newlyDamaged | std::exchange(m_previouslyDamagedScreens, newlyDamaged);
+    QList<int> damagedIndices;
+    if (!damaged.isEmpty()) {
+        const auto screens = effects->screens();
+        for (int i = 0; i < screens.size(); ++i) {
+            if (damaged.contains(screens.at(i))) damagedIndices.append(i);
+        }
+    }
+
+    m_displayTextureUpdatesThisFrame = 0;
+    if (!damagedIndices.isEmpty()) Q_EMIT screenContentsDamaged(damagedIndices);
+
+    // the displays' handlers report their updates synchronously
+    int visibleDisplays = 0;
+    for (int i = 0; i < m_displayBounds.size(); ++i) {
+        const bool culled = i < CULLING_MAX_DISPLAYS && (m_culledDisplayMask & (1 << i));
+        if (m_displayBounds.at(i).radius >= 0 && !culled) ++visibleDisplays;
+    }
+    m_displayTextureUpdates += m_displayTextureUpdatesThisFrame;
+    m_displayTextureUpdatesSkipped += std::max(0, visibleDisplays - m_displayTextureUpdatesThisFrame);
+}
+
+void BreezyDesktopEffect::reportDisplayTextureUpdated()
+{
+    ++m_displayTextureUpdatesThisFrame;
+}
+
+void BreezyDesktopEffect::setNativeScene(const QVariantMap &scene)
+{
+    QList<BreezyDesktopNativeRenderer::Display> displays;
+    const QVariantList displayList = scene.value(QStringLiteral("displays")).toList();
+    for (const QVariant &displayVariant : displayList) {
+        const QVariantMap displayMap = displayVariant.toMap();
+        BreezyDesktopNativeRenderer::Display display;
+        display.screenIndex = displayMap.value(QStringLiteral("screenIndex"), -1).toInt();
+        display.model = displayMap.value(QStringLiteral("model")).value<QMatrix4x4>();
+
+        const QVariantList vertices = displayMap.value(QStringLiteral("vertices")).toList();
+        display.vertices.reserve(vertices.size());
+        for (const QVariant &value : vertices) {
+            display.vertices.push_back(value.toFloat());
+        }
+        displays.append(std::move(display));
+    }
+
+    setCameraDistances(scene.value(QStringLiteral("lensDistancePixels")).toReal(),
+                       scene.value(QStringLiteral("fullScreenDistancePixels")).toReal());
 
-    // Monitor the IPC file for changes, even if it doesn't exist at startup
-    m_shmDirectoryWatcher = new QFileSystemWatcher(this);
-    m_shmDirectoryWatcher->addPath(DataView::SHM_DIR);
+    if (!m_nativeRenderer) m_nativeRenderer = std::make_unique<BreezyDesktopNativeRenderer>();
+    m_nativeRenderer->setDisplays(displays);
+    if (updateEffectOnScreenGeometryCache()) effects->addRepaint(m_effectOnScreenGeometry);
+}
 
-    m_shmFileWatcher = new QFileSystemWatcher(this);
+void BreezyDesktopEffect::paintTimewarp(const RenderTarget &renderTarget, const RenderViewport &viewport, int mask, const PaintRegion &region, ScreenOutput *screen)
+{
+    if (!m_timewarp) m_timewarp = std::make_unique<BreezyDesktopTimewarp>();
 
-    // Setup file watcher with recreation detection
-    auto setupFileWatcher = [this]() {
-        if (QFile::exists(DataView::SHM_PATH) && (
-            m_poseTimestamp == 0 || 
-            QDateTime::currentMSecsSinceEpoch() - m_poseTimestamp > 50 || // file may have been deleted and recreated
-            !m_shmFileWatcher->files().contains(DataView::SHM_PATH)
-        )) {
-            m_shmFileWatcher->removePath(DataView::SHM_PATH);
-            disconnect(m_shmFileWatcher, &QFileSystemWatcher::fileChanged, this, &BreezyDesktopEffect::updatePose);
-            m_shmFileWatcher->addPath(DataView::SHM_PATH);
-            connect(m_shmFileWatcher, &QFileSystemWatcher::fileChanged, this, &BreezyDesktopEffect::updatePose);
-        }
-    };
+    const QRect geometry = screen->geometry();
+    const QSize textureSize = (QSizeF(geometry.size()) * viewport.scale()).toSize();
 
-    // Handle directory changes (file creation/recreation)
-    connect(m_shmDirectoryWatcher, &QFileSystemWatcher::directoryChanged, this, setupFileWatcher);
+    // decided in prePaintScreen, where the scene was either rendered or left alone
+    const bool reproject = m_timewarpReprojecting && m_timewarp->hasFrame(textureSize);
 
-    // Initial setup
-    setupFileWatcher();
+    const QQuaternion displayOrientation = QQuaternion::fromEulerAngles(m_cameraEulerRotation);
+    if (!reproject) {
+        GLFramebuffer *framebuffer = m_timewarp->sceneFramebuffer(textureSize);
+        if (!framebuffer) {
+            QuickSceneEffect::paintScreen(renderTarget, viewport, mask, region, screen);
+            return;
+        }
 
-    m_watchdogTimer = new QTimer(this);
-    m_watchdogTimer->setInterval(1000);
-    connect(m_watchdogTimer, &QTimer::timeout, this, [this]() {
-        if (!m_enabled) return;
-        this->updatePose();
-    });
-    m_watchdogTimer->start();
+        GLFramebuffer::pushFramebuffer(framebuffer);
+        glClearColor(0.0, 0.0, 0.0, 0.0);
+        glClear(GL_COLOR_BUFFER_BIT);
+        RenderTarget sceneTarget(framebuffer);
+        RenderViewport sceneViewport(geometry, viewport.scale(), sceneTarget);
+        QuickSceneEffect::paintScreen(sceneTarget, sceneViewport, mask, region, screen);
+        GLFramebuffer::popFramebuffer();
 
-    m_cursorUpdateTimer = new QTimer(this);
-    connect(m_cursorUpdateTimer, &QTimer::timeout, this, &BreezyDesktopEffect::updateCursorPos);
-    m_cursorUpdateTimer->setInterval(16); // ~60Hz
-    m_cursorUpdateTimer->start();
+        m_timewarp->setFrameRendered();
+        m_timewarpRenderedOrientation = displayOrientation;
+    }
 
-    // Register DBus object under KWin's session bus name
-    auto *adaptor = new BreezyDesktopDBusAdaptor(this);
-    const bool dbusOk = QDBusConnection::sessionBus().registerObject(
-        QStringLiteral("/com/xronlinux/BreezyDesktop"),
-        adaptor,
-        QDBusConnection::ExportAllSlots);
-    if (!dbusOk) {
-        qCWarning(KWIN_XR) << "Failed to register DBus object /com/xronlinux/BreezyDesktop";
+    // the developer HUD is head-locked, rotating it along with the scene would make it swim on reprojected frames
+    const QRectF headLockedRect = m_developerMode ? m_hudRect : QRectF();
+    if (!m_timewarp->paint(viewport, geometry, m_timewarpRenderedOrientation, displayOrientation, fovHalfTangents(),
+                           headLockedRect)) {
+        QuickSceneEffect::paintScreen(renderTarget, viewport, mask, region, screen);
+        return;
     }
+    m_timewarpPresentedOrientation = displayOrientation;
+    m_timewarpPresentedValid = true;
 }
 
-BreezyDesktopEffect::~BreezyDesktopEffect()
+void BreezyDesktopEffect::postPaintScreen()
 {
-    qCCritical(KWIN_XR) << "\t\t\tBreezy - destructor";
-    if (m_shmFileWatcher) {
-        if (!DataView::SHM_PATH.isEmpty()) {
-            m_shmFileWatcher->removePath(DataView::SHM_PATH);
-        }
-        m_shmFileWatcher->deleteLater();
-        m_shmFileWatcher = nullptr;
-    }
-    if (m_shmDirectoryWatcher) {
-        m_shmDirectoryWatcher->deleteLater();
-        m_shmDirectoryWatcher = nullptr;
-    }
-    if (m_watchdogTimer) {
-        m_watchdogTimer->stop();
-        m_watchdogTimer->deleteLater();
-        m_watchdogTimer = nullptr;
+    BREEZY_TRACE_SCOPE("postPaintScreen");
+    QuickSceneEffect::postPaintScreen();
+
+    if (!m_paintingEffectScreen) return;
+    m_paintingEffectScreen = false;
+
+    // The Quick view is polished and rendered in prePaintScreen and drawn in paintScreen, so the frame's cost is the
+    // whole span. CPU time only, which is also all that's measured without stalling the compositor on the GPU.
+    const double frameCostMs = std::chrono::duration<double, std::milli>(steadyNow() - m_frameStart).count();
+    m_paintTime.add(frameCostMs);
+    m_statistics.frameTime.add(frameCostMs);
+    if (m_developerMode) m_hudWindow.frameTime.add(frameCostMs);
+
+    // a reprojected frame didn't render the scene, its cost says nothing about the quality level
+    if (!m_timewarpReprojecting) updateRenderQuality(frameCostMs);
+
+    recordPoseSubmitted();
+    reportFrameStatistics();
+
+    // with the FrameAnimation path disabled, nothing else keeps frames coming while the head moves. With suppression,
+    // the next frame is requested by a pose sample that moves the view (updatePose), damage, cursor motion or animations.
+    m_continuousRepaintRequested = (m_lateLatchPose || nativeBackendActive()) &&
+        (!m_repaintSuppression || m_animationsActive || !m_renderedPoseValid);
+    if (m_continuousRepaintRequested) effects->addRepaint(m_effectOnScreenGeometry);
+}
+
+bool BreezyDesktopEffect::poseMovedSinceRender(const CameraPose &pose) const
+{
+    if (!m_renderedPoseValid || m_displayResolution.size() < 2) return true;
+
+    const qreal diagonalPixels = std::hypot(m_displayResolution[0], m_displayResolution[1]);
+    if (diagonalPixels <= 0 || m_diagonalFOV <= 0) return true;
+
+    const qreal thresholdDegrees = m_diagonalFOV / diagonalPixels * REPAINT_POSE_THRESHOLD_PIXELS;
+    if (angularDistanceDegrees(QQuaternion::fromEulerAngles(pose.eulerRotation), m_renderedCameraRotation) > thresholdDegrees) return true;
+
+    // scene units are pixels at the full screen distance
+    return (cameraPosition(pose.orientation) - m_renderedCameraPosition).length() > REPAINT_POSE_THRESHOLD_PIXELS;
+}
+
+void BreezyDesktopEffect::requestRepaintIfPoseMoved()
+{
+    if (!m_repaintSuppression || !(m_lateLatchPose || nativeBackendActive())) return;
+
+    // only decides whether a frame is needed, prePaintScreen latches the pose that frame is rendered with
+    ++m_poseSamples;
+    const std::optional<CameraPose> pose = predictCameraPose();
+    if (pose && poseMovedSinceRender(*pose)) {
+        if (updateEffectOnScreenGeometryCache()) effects->addRepaint(m_effectOnScreenGeometry);
+    } else {
+        ++m_poseSamplesSuppressed;
     }
-    deactivate();
 }
 
-void BreezyDesktopEffect::setupGlobalShortcut(const BreezyShortcuts::Shortcut &shortcut, std::function<void()> triggeredFunc) {
-    QAction *action = new QAction(this);
-    action->setObjectName(shortcut.actionName);
-    action->setText(shortcut.actionText);
-    KGlobalAccel::self()->setDefaultShortcut(action, {shortcut.shortcut});
-    KGlobalAccel::self()->setShortcut(action, {shortcut.shortcut});
-    connect(action, &QAction::triggered, this, triggeredFunc);
+// C++ port of CameraController.qml's ratesOfChange, lookAheadMS, and applyLookAhead
+std::optional<BreezyDesktopEffect::CameraPose> BreezyDesktopEffect::predictCameraPose() const
+{
+    BREEZY_TRACE_SCOPE("predict camera pose");
+    const bool useOrigin = m_focusedSmoothFollowEnabled || steadyNow() < m_smoothFollowDisablingUntil;
+    const QList<QQuaternion> &orientations = useOrigin ? m_smoothFollowOrigin : m_poseOrientations;
+    if (orientations.size() < 2 || m_lookAheadConfig.isEmpty()) return std::nullopt;
+
+    const QVector3D eulerEnd = orientations[0].toEulerAngles();
+    const QVector3D eulerStart = orientations[1].toEulerAngles();
+    const QVector3D degreesPerMs = m_poseTimeElapsedMs > 0 ?
+        (eulerEnd - eulerStart) / static_cast<float>(m_poseTimeElapsedMs) :
+        QVector3D();
+
+    const qreal dataAge = QDateTime::currentMSecsSinceEpoch() - static_cast<qint64>(m_poseTimestamp);
+    const qreal lookAheadConstant = m_lookAheadOverride == -1 ? m_lookAheadConfig[0] : m_lookAheadOverride;
+    const float lookAheadMs = static_cast<float>(lookAheadConstant + dataAge);
+
+    CameraPose pose;
+    pose.eulerRotation = eulerEnd + degreesPerMs * lookAheadMs;
+    pose.orientation = orientations[0];
+    pose.angularRates = degreesPerMs * qDegreesToRadians(1.0f);
+    pose.lookAheadMs = lookAheadMs;
+    return pose;
+}
+
+bool BreezyDesktopEffect::latchCameraPose()
+{
+    const std::optional<CameraPose> pose = predictCameraPose();
+    if (!pose) return false;
+
+    m_cameraEulerRotation = pose->eulerRotation;
+    m_cameraOrientation = pose->orientation;
+    m_cameraAngularRates = pose->angularRates;
+    if (m_developerMode) m_hudWindow.lookAhead.add(pose->lookAheadMs);
+    return true;
 }
 
-void BreezyDesktopEffect::recenter() {
-    QJsonObject flags; 
-    flags.insert(QStringLiteral("recenter_screen"), true);
-    XRDriverIPC::instance().writeControlFlags(flags);
+void BreezyDesktopEffect::reportCameraPoseApplied(quint64 poseTimestamp)
+{
+    BREEZY_TRACE_SCOPE("camera pose applied (frame animation)");
+    m_appliedPoseTimestamp = poseTimestamp;
+    m_cameraAppliedAt = steadyNow();
+
+    if (m_developerMode && !m_lookAheadConfig.isEmpty()) {
+        // what CameraController.qml's lookAheadMS() just predicted the camera with
+        const qreal lookAheadConstant = m_lookAheadOverride == -1 ? m_lookAheadConfig[0] : m_lookAheadOverride;
+        m_hudWindow.lookAhead.add(lookAheadConstant + QDateTime::currentMSecsSinceEpoch() - static_cast<qint64>(poseTimestamp));
+    }
 }
 
-void BreezyDesktopEffect::setLookingAtScreenIndex(int index)
+void BreezyDesktopEffect::recordPoseSubmitted()
 {
-    m_lookingAtScreenIndex = index;
-    if (m_smoothFollowEnabled) updateDriverSmoothFollowSettings();
+    if (m_appliedPoseTimestamp == 0) return;
+
+    const std::chrono::nanoseconds now = steadyNow();
+    const qint64 poseAgeMs = QDateTime::currentMSecsSinceEpoch() - static_cast<qint64>(m_appliedPoseTimestamp);
+    m_poseAgeAtSubmit.add(poseAgeMs);
+    m_statistics.poseAgeAtRender.add(poseAgeMs);
+    if (m_developerMode) m_hudWindow.poseAge.add(poseAgeMs);
+    BREEZY_TRACE_COUNTER("pose age at submit (ms)", poseAgeMs);
+#ifdef BREEZY_DESKTOP_TRACING
+    if (m_appliedPoseTimestamp == m_tracedPoseTimestamp) {
+        BREEZY_TRACE_ASYNC_END("pose", m_tracedPoseTimestamp);
+        m_tracedPoseTimestamp = 0;
+    }
+#endif
+    m_applyToSubmit.add(std::chrono::duration<double, std::milli>(now - m_cameraAppliedAt).count());
+
+    if (now - m_poseStatsReportedAt < STATS_REPORT_INTERVAL) return;
+    m_poseStatsReportedAt = now;
+
+    if (m_developerMode) {
+        qCInfo(KWIN_XR) << "\t\t\tBreezy - pose age at submit" << (m_lateLatchPose ? "(late latch):" : "(frame animation):")
+                        << "avg" << m_poseAgeAtSubmit.average() << "ms,"
+                        << "max" << m_poseAgeAtSubmit.max << "ms;"
+                        << "camera update to submit avg" << m_applyToSubmit.average() << "ms,"
+                        << "max" << m_applyToSubmit.max << "ms;"
+                        << "frames" << m_poseAgeAtSubmit.count;
+    }
+    m_poseAgeAtSubmit.reset();
+    m_applyToSubmit.reset();
 }
 
-void BreezyDesktopEffect::reconfigure(ReconfigureFlags)
+void BreezyDesktopEffect::reportFrameStatistics()
 {
-    BreezyDesktopConfig::self()->read();
-    setLookAheadOverride(BreezyDesktopConfig::lookAheadOverride());
-    setFocusedDisplayDistance(BreezyDesktopConfig::focusedDisplayDistance() / 100.0f);
-    setAllDisplaysDistance(BreezyDesktopConfig::allDisplaysDistance() / 100.0f);
-    setDisplaySpacing(BreezyDesktopConfig::displaySpacing() / 1000.0f);
-    setDisplaySize(BreezyDesktopConfig::displaySize() / 100.0f);
-    setZoomOnFocusEnabled(BreezyDesktopConfig::zoomOnFocusEnabled());
-    setSmoothFollowThreshold(BreezyDesktopConfig::smoothFollowThreshold());
+    // each report logs in developer mode and starts its subsystem's next period either way
+    const std::chrono::nanoseconds now = steadyNow();
+    if (now - m_frameStatsReportedAt < STATS_REPORT_INTERVAL) return;
+    m_frameStatsReportedAt = now;
+
+    reportFrameCost();
+    reportTimewarpStatistics();
+    reportCullingStatistics();
+    reportDisplayMeshStatistics();
+    reportScreenTextureStatistics();
+    reportRenderQuality();
+    reportRepaintSuppression();
+    reportFocusLodStatistics();
+    reportDisplayTextureUpdates();
+}
+
+void BreezyDesktopEffect::reportFrameCost()
+{
+    if (m_developerMode) {
+        const char *paintPath = nativeBackendActive() ? "(native OpenGL):" :
+            m_instancedDisplaysActive ? "(QtQuick3D, instanced):" : "(QtQuick3D, per display):";
+        qCInfo(KWIN_XR) << "\t\t\tBreezy - frame cost" << paintPath
+                        << "avg" << m_paintTime.average() << "ms,"
+                        << "min" << m_paintTime.min << "ms,"
+                        << "max" << m_paintTime.max << "ms;"
+                        << "frames" << m_paintTime.count;
+    }
+    m_paintTime.reset();
+}
 
-    qreal horiz = BreezyDesktopConfig::displayHorizontalOffset() / 100.0f;
-    qreal vert = BreezyDesktopConfig::displayVerticalOffset() / 100.0f;
-    bool offsetchanged = false;
-    if (!qFuzzyCompare(m_displayHorizontalOffset, horiz)) { m_displayHorizontalOffset = horiz; offsetchanged = true; }
-    if (!qFuzzyCompare(m_displayVerticalOffset, vert)) { m_displayVerticalOffset = vert; offsetchanged = true; }
-    if (offsetchanged) Q_EMIT displayOffsetChanged();
+void BreezyDesktopEffect::reportTimewarpStatistics()
+{
+    if (m_developerMode && timewarpActive()) {
+        qCInfo(KWIN_XR) << "\t\t\tBreezy - timewarp: reprojected frames" << m_timewarpReprojectedFrames
+                        << "of" << m_timewarpFrames << ";"
+                        << "residual angular error avg" << m_timewarpResidualError.average() << "deg,"
+                        << "max" << m_timewarpResidualError.max << "deg;"
+                        << "without reprojection avg" << m_timewarpStaleError.average() << "deg,"
+                        << "max" << m_timewarpStaleError.max << "deg;"
+                        << "last scene render" << std::chrono::duration<double, std::milli>(m_lastSceneRenderCost).count() << "ms";
+    }
+    m_timewarpResidualError.reset();
+    m_timewarpStaleError.reset();
+    m_timewarpFrames = 0;
+    m_timewarpReprojectedFrames = 0;
+}
 
-    int wrap = BreezyDesktopConfig::displayWrappingScheme();
-    int aaQuality = BreezyDesktopConfig::antialiasingQuality();
-    bool removeVD = BreezyDesktopConfig::removeVirtualDisplaysOnDisable();
-    bool mirrorPhysicalDisplays = BreezyDesktopConfig::mirrorPhysicalDisplays();
-    if (m_displayWrappingScheme != wrap) { m_displayWrappingScheme = wrap; Q_EMIT displayWrappingSchemeChanged(); }
-    if (m_antialiasingQuality != aaQuality) { m_antialiasingQuality = aaQuality; Q_EMIT antialiasingQualityChanged(); }
-    if (m_removeVirtualDisplaysOnDisable != removeVD) { m_removeVirtualDisplaysOnDisable = removeVD; Q_EMIT removeVirtualDisplaysOnDisableChanged(); }
-    if (m_mirrorPhysicalDisplays != mirrorPhysicalDisplays) { m_mirrorPhysicalDisplays = mirrorPhysicalDisplays; Q_EMIT mirrorPhysicalDisplaysChanged(); }
+void BreezyDesktopEffect::reportCullingStatistics()
+{
+    if (m_developerMode && m_displayCulling) {
+        qCInfo(KWIN_XR) << "\t\t\tBreezy - culled displays per frame: avg" << m_culledDisplays.average()
+                        << "max" << m_culledDisplays.max << "of" << m_displayBounds.size();
+    }
+    m_culledDisplays.reset();
+}
 
-    const bool developerMode = BreezyDesktopConfig::developerMode();
-    if (m_developerMode != developerMode) { m_developerMode = developerMode; Q_EMIT developerModeChanged(); }
+void BreezyDesktopEffect::reportDisplayMeshStatistics()
+{
+    // the meshes' current state, nothing accumulates
+    if (!m_developerMode) return;
+
+    int meshDisplays = 0;
+    int meshVertices = 0;
+    qreal meshMaxError = 0.0;
+    for (const DisplayMeshStats &mesh : std::as_const(m_displayMeshStats)) {
+        if (mesh.vertexCount < 0) continue;
+        ++meshDisplays;
+        meshVertices += mesh.vertexCount;
+        meshMaxError = std::max(meshMaxError, mesh.errorPixels);
+    }
+    if (meshDisplays > 0) {
+        qCInfo(KWIN_XR) << "\t\t\tBreezy - display meshes:" << meshVertices << "vertices over" << meshDisplays << "displays;"
+                        << "max curve error" << meshMaxError << "px";
+    }
+}
 
-    bool curved = BreezyDesktopConfig::curvedDisplay() && m_curvedDisplaySupported;
-    if (m_curvedDisplay != curved) { m_curvedDisplay = curved; Q_EMIT curvedDisplayChanged(); }
+void BreezyDesktopEffect::reportScreenTextureStatistics()
+{
+    if (!m_screenTextures) return;
+
+    BreezyStats::RunningStat &renderTime = m_screenTextures->renderTime();
+    if (m_developerMode) {
+        qCInfo(KWIN_XR) << "\t\t\tBreezy - screen textures" << (displayTextureSource() == 1 || nativeBackendActive() ? "(in use):" : "(unused, window thumbnails):")
+                        << renderTime.count << "renders;"
+                        << "avg" << renderTime.average() << "ms,"
+                        << "max" << renderTime.max << "ms;"
+                        << m_screenTextures->rateLimitedUpdates() << "held back by virtual display texture update caps";
+    }
+    renderTime.reset();
+    m_screenTextures->rateLimitedUpdates() = 0;
+}
 
-    // this one doesn't have a signal, just always assign it
-    m_allDisplaysFollowMode = BreezyDesktopConfig::allDisplaysFollowMode();
+void BreezyDesktopEffect::reportRenderQuality()
+{
+    if (!m_developerMode || !autoQualityActive()) return;
+    qCInfo(KWIN_XR) << "\t\t\tBreezy - auto quality: antialiasing" << m_renderQuality.antialiasingQuality
+                    << "render scale" << m_renderQuality.renderScale << ";"
+                    << "level changes" << m_qualityChanges;
 }
 
-bool BreezyDesktopEffect::developerMode() const
+void BreezyDesktopEffect::reportRepaintSuppression()
 {
-    return m_developerMode;
+    if (m_developerMode && m_repaintSuppression) {
+        qCInfo(KWIN_XR) << "\t\t\tBreezy - static pose repaint suppression: pose samples without a repaint"
+                        << m_poseSamplesSuppressed << "of" << m_poseSamples;
+    }
+    m_poseSamples = 0;
+    m_poseSamplesSuppressed = 0;
 }
 
-QVariantMap BreezyDesktopEffect::initialProperties(ScreenOutput *screen)
+void BreezyDesktopEffect::reportFocusLodStatistics()
 {
-    return QVariantMap{
-        {QStringLiteral("effect"), QVariant::fromValue(this)},
-        {QStringLiteral("targetScreen"), QVariant::fromValue(screen)}
-    };
+    // logged right after the frame cost of the same period, so both can be compared across LOD settings
+    if (!m_developerMode || nativeBackendActive()) return;
+
+    qCInfo(KWIN_XR) << "\t\t\tBreezy - focus LOD" << (m_focusLodEnabled ? "on," : "off,")
+                    << "unfocused texture scale" << m_unfocusedTextureScale << ";"
+                    << "screen texture memory" << (m_screenTextures ? m_screenTextures->textureMemoryBytes() / (1024.0 * 1024.0) : 0.0) << "MiB"
+                    << (displayTextureSource() == 1 ? "" : "(window thumbnail layers not included)");
+
+    qreal fullPixels = 0.0;
+    qreal renderedPixels = 0.0;
+    qreal visiblePixels = 0.0;
+    for (const DisplayPixelBudget &budget : std::as_const(m_displayPixelBudgets)) {
+        if (budget.fullPixels < 0) continue;
+        fullPixels += budget.fullPixels;
+        renderedPixels += budget.renderedPixels;
+        visiblePixels += budget.visiblePixels;
+    }
+    if (fullPixels > 0) {
+        qCInfo(KWIN_XR) << "\t\t\tBreezy - display pixel budget, distance texture scaling"
+                        << (m_distanceTextureScaling ? "on:" : "off:")
+                        << fullPixels / 1e6 << "MP at full resolution," << renderedPixels / 1e6 << "MP rendered,"
+                        << visiblePixels / 1e6 << "MP visible on the glasses"
+                        << (instancedDisplaysActive() ? "(instanced displays use the atlas at full resolution)" : "");
+    }
 }
 
-int BreezyDesktopEffect::requestedEffectChainPosition() const
+void BreezyDesktopEffect::reportDisplayTextureUpdates()
 {
-    return 70;
+    if (m_developerMode && !nativeBackendActive()) {
+        qCInfo(KWIN_XR) << "\t\t\tBreezy - display texture updates" << (displayTextureSource() == 1 ? "(output textures):" : "(window thumbnails):")
+                        << "performed" << m_displayTextureUpdates << "of" << m_displayTextureUpdates + m_displayTextureUpdatesSkipped;
+    }
+    m_displayTextureUpdates = 0;
+    m_displayTextureUpdatesSkipped = 0;
 }
 
 void BreezyDesktopEffect::toggle()
@@ -328,14 +1471,50 @@ void BreezyDesktopEffect::activate()
         return;
     }
     qCCritical(KWIN_XR) << "\t\t\tBreezy - activate";
+    initializeDeferred();
+    m_activatedAt = steadyNow();
+    m_firstFrameAfterActivationPending = true;
+
+    // before the scene loads, so it's created with the displays already in place
+    if (!m_virtualDisplaysRestored) {
+        m_virtualDisplaysRestored = true;
+        if (m_virtualOutputs.activeDisplays().isEmpty() && m_virtualOutputs.parkedCount() == 0) {
+            const QJsonArray current = loadVirtualDisplayLayouts().value(QStringLiteral("current")).toArray();
+            applyVirtualDisplayPlacements(placementsFromJson(current), QStringLiteral("restored layout \"current\""));
+        }
+    }
+    const quint64 reconfigurations = m_virtualOutputs.reconfigurations();
+    if (const int revived = m_virtualOutputs.revive()) {
+        qCInfo(KWIN_XR) << "\t\t\tBreezy - revived" << revived << "parked virtual displays with"
+                        << m_virtualOutputs.reconfigurations() - reconfigurations << "output reconfigurations";
+    }
 
-    if (!isRunning()) setRunning(true);
+    // before the scene loads, so the displays pick their texture source right away
+    if (!m_screenTextures && effects->isOpenGLCompositing()) {
+        m_screenTextures = std::make_unique<BreezyDesktopScreenTextureCache>();
+        const auto repaint = [this]() {
+            if (updateEffectOnScreenGeometryCache()) effects->addRepaint(m_effectOnScreenGeometry);
+        };
+        connect(m_screenTextures.get(), &BreezyDesktopScreenTextureCache::screensDamaged, this, repaint);
+        connect(m_screenTextures.get(), &BreezyDesktopScreenTextureCache::acquiredScreenDamaged, this, repaint);
+        Q_EMIT screenTexturesChanged();
+    }
+    applyVirtualDisplayTextureUpdateRates();
 
-    connect(effects, &EffectsHandler::cursorShapeChanged, this, &BreezyDesktopEffect::updateCursorImage);
-    if (m_cursorUpdateTimer) {
-        m_cursorUpdateTimer->start();
+    if (!isRunning()) {
+        // instantiates main.qml for the target screen, compiling it first unless it was prewarmed
+        const std::chrono::nanoseconds instantiationStart = steadyNow();
+        setRunning(true);
+        m_sceneInstantiationMs = std::chrono::duration<double, std::milli>(steadyNow() - instantiationStart).count();
     }
 
+    connect(effects, &EffectsHandler::cursorShapeChanged, this, &BreezyDesktopEffect::updateCursorImage);
+
+    // cursor updates are driven by pointer motion and flushed once per frame in prePaintScreen
+    connect(effects, &EffectsHandler::mouseChanged, this, &BreezyDesktopEffect::cursorMoved, Qt::UniqueConnection);
+    effects->startMousePolling();
+    cursorMoved(effects->cursorPos());
+
     // QuickSceneEffect grabs the keyboard and mouse input, which pulls focus away from the active window
     // and doesn't allow for interaction with anything on the desktop. These two calls fix that.
     effects->ungrabKeyboard();
@@ -356,25 +1535,49 @@ void BreezyDesktopEffect::deactivate()
     invalidateEffectOnScreenGeometryCache();
 
     disconnect(effects, &EffectsHandler::cursorShapeChanged, this, &BreezyDesktopEffect::updateCursorImage);
-    if (m_cursorUpdateTimer) {
-        m_cursorUpdateTimer->stop();
+    if (disconnect(effects, &EffectsHandler::mouseChanged, this, &BreezyDesktopEffect::cursorMoved)) {
+        effects->stopMousePolling();
+    }
+    m_cursorUpdatePending = false;
+    m_prevCursorSample = {};
+    m_cursorSample = {};
+    m_paintingEffectScreen = false;
+    m_appliedPoseTimestamp = 0;
+    m_timewarpPresentedValid = false;
+    m_previouslyDamagedScreens.clear();
+    m_renderedPoseValid = false;
+    m_presentTime = m_lastPresentTime = std::chrono::milliseconds::zero();
+    m_continuousRepaintRequested = false;
+    if (m_timewarp || m_nativeRenderer || m_screenTextures) {
+        effects->makeOpenGLContextCurrent();
+        m_timewarp.reset();
+        m_nativeRenderer.reset();
+        if (m_screenTextures) {
+            m_screenTextures.reset();
+            Q_EMIT screenTexturesChanged();
+        }
     }
     showCursor();
 
+    // picks up positions and scales changed in the display settings since they were added
+    if (!m_virtualOutputs.activeDisplays().isEmpty()) persistVirtualDisplays();
+
     if (m_removeVirtualDisplaysOnDisable) {
-        for (auto it = m_virtualDisplays.begin(); it != m_virtualDisplays.end(); ++it) {
-            if (it->output) {
-                KWin::kwinApp()->outputBackend()->removeVirtualOutput(it->output);
-            }
+        // parked rather than removed, activate() revives them
+        const quint64 reconfigurations = m_virtualOutputs.reconfigurations();
+        if (const int parked = m_virtualOutputs.park()) {
+            qCInfo(KWIN_XR) << "\t\t\tBreezy - parked" << parked << "virtual displays with"
+                            << m_virtualOutputs.reconfigurations() - reconfigurations << "output reconfigurations";
         }
-        m_virtualDisplays.clear();
     }
+    m_outputLayoutChangesAtDeactivate = m_outputLayoutChanges;
 
     setRunning(false);
 }
 
 void BreezyDesktopEffect::enableDriver()
 {
+    BREEZY_TRACE_SCOPE("ipc: enable driver");
     qCCritical(KWIN_XR) << "\t\t\tBreezy - enableDriver";
     QJsonObject newConfig = QJsonObject();
     auto configJsonOpt = XRDriverIPC::instance().retrieveConfig();
@@ -389,6 +1592,7 @@ void BreezyDesktopEffect::enableDriver()
 
 void BreezyDesktopEffect::disableDriver()
 {
+    BREEZY_TRACE_SCOPE("ipc: disable driver");
     qCCritical(KWIN_XR) << "\t\t\tBreezy - disableDriver";
     QJsonObject newConfig = QJsonObject();
     auto configJsonOpt = XRDriverIPC::instance().retrieveConfig();
@@ -399,52 +1603,241 @@ void BreezyDesktopEffect::disableDriver()
     XRDriverIPC::instance().writeConfig(newConfig);
 }
 
-void BreezyDesktopEffect::addVirtualDisplay(QSize size)
+void BreezyDesktopEffect::addVirtualDisplay(QSize size, qreal scale, int textureUpdateRate)
 {
-    static int virtualDisplayCount = 0;
-    ++virtualDisplayCount;
-    QString name = QStringLiteral("BreezyDesktop_%1").arg(virtualDisplayCount);
-    #if defined(KWIN_VERSION_ENCODED) && KWIN_VERSION_ENCODED >= 60290
-        QString description = QStringLiteral("Breezy Display %1x%2 (%3)").arg(size.width()).arg(size.height()).arg(virtualDisplayCount);
-        auto output = KWin::kwinApp()->outputBackend()->createVirtualOutput(name, description, size, 1.0);
-    #else
-        auto output = KWin::kwinApp()->outputBackend()->createVirtualOutput(name, size, 1.0);
-    #endif
-    if (output) {
-        VirtualOutputInfo info;
-        info.output = output;
-        info.id = name;
-        info.size = size;
-        m_virtualDisplays.insert(info.id, info);
-    }
+    m_virtualOutputs.add(size, std::clamp(scale, 0.5, 3.0), std::max(textureUpdateRate, 0));
+    persistVirtualDisplays();
+    applyVirtualDisplayTextureUpdateRates();
 }
 
 QVariantList BreezyDesktopEffect::listVirtualDisplays() const {
     QVariantList list;
-    for (auto it = m_virtualDisplays.constBegin(); it != m_virtualDisplays.constEnd(); ++it) {
-        const auto &info = it.value();
-        if (!info.output)
-            continue;
+    const auto displays = m_virtualOutputs.activeDisplays();
+    for (const auto &display : displays) {
         QVariantMap entry;
-        entry.insert(QStringLiteral("id"), info.id);
-        entry.insert(QStringLiteral("width"), info.size.width());
-        entry.insert(QStringLiteral("height"), info.size.height());
+        entry.insert(QStringLiteral("id"), display.id);
+        entry.insert(QStringLiteral("width"), display.size.width());
+        entry.insert(QStringLiteral("height"), display.size.height());
+        entry.insert(QStringLiteral("scale"), display.output->scale());
+        entry.insert(QStringLiteral("textureUpdateRate"), display.textureUpdateRate);
         list.push_back(entry);
     }
     return list;
 }
 
+QVariantMap BreezyDesktopEffect::statistics() const
+{
+    const auto percentiles = [](const BreezyStats::AtomicHistogram &histogram) {
+        QVariantMap map;
+        map.insert(QStringLiteral("count"), histogram.count());
+        map.insert(QStringLiteral("p50"), histogram.percentile(0.50));
+        map.insert(QStringLiteral("p95"), histogram.percentile(0.95));
+        map.insert(QStringLiteral("p99"), histogram.percentile(0.99));
+        return map;
+    };
+
+    QVariantMap poseSamples;
+    poseSamples.insert(QStringLiteral("received"), m_statistics.poseSamples.load());
+    poseSamples.insert(QStringLiteral("rejectedSize"), m_statistics.poseRejectedSize.load());
+    poseSamples.insert(QStringLiteral("rejectedParity"), m_statistics.poseRejectedParity.load());
+    poseSamples.insert(QStringLiteral("rejectedVersion"), m_statistics.poseRejectedVersion.load());
+
+    QVariantMap ipc;
+    ipc.insert(QStringLiteral("calls"), m_statistics.ipcCalls.load());
+    ipc.insert(QStringLiteral("failures"), m_statistics.ipcFailures.load());
+    ipc.insert(QStringLiteral("latencyMs"), percentiles(m_statistics.ipcLatency));
+
+    QVariantMap virtualDisplays;
+    virtualDisplays.insert(QStringLiteral("active"), m_virtualOutputs.activeDisplays().size());
+    virtualDisplays.insert(QStringLiteral("parked"), m_virtualOutputs.parkedCount());
+
+    QVariantMap stats;
+    stats.insert(QStringLiteral("enabled"), m_enabled);
+    stats.insert(QStringLiteral("poseSamples"), poseSamples);
+    stats.insert(QStringLiteral("poseAgeAtRenderMs"), percentiles(m_statistics.poseAgeAtRender));
+    stats.insert(QStringLiteral("frameTimeMs"), percentiles(m_statistics.frameTime));
+    stats.insert(QStringLiteral("cursorUpdates"), m_statistics.cursorUpdates.load());
+    stats.insert(QStringLiteral("ipc"), ipc);
+    stats.insert(QStringLiteral("virtualDisplays"), virtualDisplays);
+    return stats;
+}
+
+void BreezyDesktopEffect::updateHudTimer()
+{
+    if (!m_developerMode || !m_enabled) {
+        m_hudTimer->stop();
+        return;
+    }
+    if (m_hudTimer->isActive()) return;
+
+    resetHudWindow();
+    m_hudTimer->start();
+}
+
+void BreezyDesktopEffect::resetHudWindow()
+{
+    m_hudWindow = HudWindow();
+    m_hudWindow.poseSamples = m_statistics.poseSamples.load();
+    m_hudWindow.rejectedSamples = rejectedPoseSamples();
+    m_hudWindow.startedAt = steadyNow();
+}
+
+quint64 BreezyDesktopEffect::rejectedPoseSamples() const
+{
+    return m_statistics.poseRejectedSize.load() + m_statistics.poseRejectedParity.load() +
+        m_statistics.poseRejectedVersion.load();
+}
+
+void BreezyDesktopEffect::setHudRect(const QRectF &rect)
+{
+    m_hudRect = rect;
+}
+
+void BreezyDesktopEffect::updateHudStatistics()
+{
+    const double windowSeconds = std::chrono::duration<double>(steadyNow() - m_hudWindow.startedAt).count();
+    const quint64 poseSamples = m_statistics.poseSamples.load() - m_hudWindow.poseSamples;
+    const quint64 rejectedSamples = rejectedPoseSamples() - m_hudWindow.rejectedSamples;
+
+    // the texture scale each display renders at, from the pixel budget its BreezyDesktopDisplay reports in developer
+    // mode; -1 for indices without a display
+    QVariantList displayLods;
+    for (const DisplayPixelBudget &budget : std::as_const(m_displayPixelBudgets)) {
+        displayLods.append(budget.fullPixels > 0 ? std::sqrt(budget.renderedPixels / budget.fullPixels) : -1.0);
+    }
+
+    QVariantMap hud;
+    hud.insert(QStringLiteral("frameTimeMs"), m_hudWindow.frameTime.average());
+    hud.insert(QStringLiteral("frameTimeMaxMs"), m_hudWindow.frameTime.max);
+    hud.insert(QStringLiteral("frames"), m_hudWindow.frameTime.count);
+    hud.insert(QStringLiteral("poseRateHz"), windowSeconds > 0 ? poseSamples / windowSeconds : 0.0);
+    hud.insert(QStringLiteral("poseAgeMs"), m_hudWindow.poseAge.average());
+    hud.insert(QStringLiteral("lookAheadMs"), m_hudWindow.lookAhead.average());
+    hud.insert(QStringLiteral("droppedSampleRateHz"), windowSeconds > 0 ? rejectedSamples / windowSeconds : 0.0);
+    hud.insert(QStringLiteral("focusedDisplay"), m_lookingAtScreenIndex);
+    hud.insert(QStringLiteral("displayLods"), displayLods);
+    m_hudStatistics = hud;
+    resetHudWindow();
+    Q_EMIT hudStatisticsChanged();
+}
+
+QVariantMap BreezyDesktopEffect::hudStatistics() const
+{
+    return m_hudStatistics;
+}
+
+void BreezyDesktopEffect::applyVirtualDisplayTextureUpdateRates()
+{
+    // Virtual outputs only have the one mode they're created with, and createVirtualOutput() takes no rate, so KWin
+    // still composites them at that mode's rate. The cap is applied where the effect spends its own time on them:
+    // re-rendering their output textures here, and BreezyDesktopDisplay.qml's thumbnail layer through
+    // textureUpdateRates. Screens are matched by name, which is the display's id.
+    const auto displays = m_virtualOutputs.activeDisplays();
+    QVariantMap rates;
+    for (const auto &display : displays) {
+        if (display.textureUpdateRate > 0) rates.insert(display.id, display.textureUpdateRate);
+    }
+    if (rates != m_textureUpdateRates) {
+        m_textureUpdateRates = rates;
+        Q_EMIT textureUpdateRatesChanged();
+    }
+
+    if (!m_screenTextures) return;
+    const auto screens = effects->screens();
+    for (ScreenOutput *screen : screens) {
+        int textureUpdateRate = 0;
+        for (const auto &display : displays) {
+            if (display.id == screen->name()) textureUpdateRate = display.textureUpdateRate;
+        }
+        m_screenTextures->setUpdateRateLimit(screen, textureUpdateRate);
+    }
+}
+
 bool BreezyDesktopEffect::removeVirtualDisplay(const QString &id) {
-    auto it = m_virtualDisplays.find(id);
-    if (it != m_virtualDisplays.end()) {
-        VirtualOutputHandle *output = it->output;
-        if (output) {
-            KWin::kwinApp()->outputBackend()->removeVirtualOutput(output);
+    if (!m_virtualOutputs.remove(id)) return false;
+    persistVirtualDisplays();
+    applyVirtualDisplayTextureUpdateRates();
+    return true;
+}
+
+QStringList BreezyDesktopEffect::listVirtualDisplayLayouts() const {
+    return loadVirtualDisplayLayouts().value(QStringLiteral("layouts")).toObject().keys();
+}
+
+bool BreezyDesktopEffect::saveVirtualDisplayLayout(const QString &name) {
+    if (name.isEmpty()) return false;
+    QJsonObject file = loadVirtualDisplayLayouts();
+    QJsonObject layouts = file.value(QStringLiteral("layouts")).toObject();
+    layouts.insert(name, placementsToJson(m_virtualOutputs.placements()));
+    file.insert(QStringLiteral("layouts"), layouts);
+    saveVirtualDisplayLayouts(file);
+    return true;
+}
+
+bool BreezyDesktopEffect::restoreVirtualDisplayLayout(const QString &name) {
+    const QJsonObject layouts = loadVirtualDisplayLayouts().value(QStringLiteral("layouts")).toObject();
+    if (!layouts.contains(name)) return false;
+    const bool restored = applyVirtualDisplayPlacements(placementsFromJson(layouts.value(name).toArray()),
+                                                        QStringLiteral("restored layout \"%1\"").arg(name));
+    persistVirtualDisplays();
+    applyVirtualDisplayTextureUpdateRates();
+    return restored;
+}
+
+bool BreezyDesktopEffect::removeVirtualDisplayLayout(const QString &name) {
+    QJsonObject file = loadVirtualDisplayLayouts();
+    QJsonObject layouts = file.value(QStringLiteral("layouts")).toObject();
+    if (!layouts.contains(name)) return false;
+    layouts.remove(name);
+    file.insert(QStringLiteral("layouts"), layouts);
+    saveVirtualDisplayLayouts(file);
+    return true;
+}
+
+bool BreezyDesktopEffect::applyVirtualDisplays(const QList<QVariantMap> &displays) {
+    QList<BreezyDesktopVirtualOutputPool::Placement> placements;
+    for (const QVariantMap &display : displays) {
+        BreezyDesktopVirtualOutputPool::Placement placement;
+        placement.id = display.value(QStringLiteral("id")).toString();
+        placement.size = QSize(display.value(QStringLiteral("width")).toInt(), display.value(QStringLiteral("height")).toInt());
+        if (placement.size.isEmpty()) {
+            qCWarning(KWIN_XR) << "\t\t\tBreezy - ApplyVirtualDisplays: ignoring display without a size" << display;
+            continue;
         }
-        m_virtualDisplays.erase(it);
-        return true;
+        if (display.contains(QStringLiteral("x")) && display.contains(QStringLiteral("y"))) {
+            placement.position = QPoint(display.value(QStringLiteral("x")).toInt(), display.value(QStringLiteral("y")).toInt());
+        }
+        placement.scale = std::clamp(display.value(QStringLiteral("scale"), 1.0).toDouble(), 0.5, 3.0);
+        placement.textureUpdateRate = std::max(display.value(QStringLiteral("textureUpdateRate")).toInt(), 0);
+        placements.append(placement);
     }
-    return false;
+
+    const bool applied = applyVirtualDisplayPlacements(placements, QStringLiteral("applied"));
+    persistVirtualDisplays();
+    applyVirtualDisplayTextureUpdateRates();
+    return applied;
+}
+
+bool BreezyDesktopEffect::applyVirtualDisplayPlacements(const QList<BreezyDesktopVirtualOutputPool::Placement> &placements,
+                                                         const QString &description) {
+    if (placements.isEmpty() && m_virtualOutputs.activeDisplays().isEmpty()) return true;
+
+    QElapsedTimer timer;
+    timer.start();
+    const quint64 reconfigurations = m_virtualOutputs.reconfigurations();
+    const quint64 layoutChanges = m_outputLayoutChanges;
+    const bool restored = m_virtualOutputs.restore(placements);
+    qCInfo(KWIN_XR) << "\t\t\tBreezy - virtual displays" << description << "-" << placements.size() << "displays in"
+                    << timer.elapsed() << "ms," << m_virtualOutputs.reconfigurations() - reconfigurations
+                    << "output reconfigurations," << m_outputLayoutChanges - layoutChanges << "output layout changes"
+                    << (restored ? "" : "(incomplete)");
+    return restored;
+}
+
+void BreezyDesktopEffect::persistVirtualDisplays() {
+    QJsonObject file = loadVirtualDisplayLayouts();
+    file.insert(QStringLiteral("current"), placementsToJson(m_virtualOutputs.placements()));
+    saveVirtualDisplayLayouts(file);
 }
 
 bool BreezyDesktopEffect::isEnabled() const {
@@ -477,6 +1870,7 @@ void BreezyDesktopEffect::setZoomOnFocusEnabled(bool enabled) {
 }
 
 void BreezyDesktopEffect::toggleSmoothFollow() {
+    BREEZY_TRACE_SCOPE("ipc: toggle smooth follow");
     QJsonObject flags;
     flags.insert(QStringLiteral("toggle_breezy_desktop_smooth_follow"), true);
     XRDriverIPC::instance().writeControlFlags(flags);
@@ -605,6 +1999,39 @@ int BreezyDesktopEffect::antialiasingQuality() const {
     return m_antialiasingQuality;
 }
 
+int BreezyDesktopEffect::effectiveAntialiasingQuality() const {
+    return m_renderQuality.antialiasingQuality;
+}
+
+qreal BreezyDesktopEffect::renderScale() const {
+    return m_renderQuality.renderScale;
+}
+
+bool BreezyDesktopEffect::autoQualityActive() const {
+    // the native backend doesn't antialias or scale, nothing to govern there
+    return m_antialiasingQuality == 4 && !nativeBackendActive();
+}
+
+void BreezyDesktopEffect::updateRenderQuality(double frameCostMs)
+{
+    if (!autoQualityActive()) return;
+
+    // a present more than half an interval late while frames were requested back to back means vsync was missed
+    const double intervalMs = std::chrono::duration<double, std::milli>(m_frameInterval).count();
+    const bool missedVsync = m_continuousRepaintRequested && m_lastPresentTime.count() > 0 &&
+        (m_presentTime - m_lastPresentTime).count() > intervalMs * 1.5;
+
+    if (!m_qualityGovernor.addFrame(frameCostMs, intervalMs, missedVsync)) return;
+
+    m_renderQuality = m_qualityGovernor.level();
+    ++m_qualityChanges;
+    if (m_developerMode) {
+        qCInfo(KWIN_XR) << "\t\t\tBreezy - auto quality: antialiasing" << m_renderQuality.antialiasingQuality
+                        << "render scale" << m_renderQuality.renderScale;
+    }
+    Q_EMIT renderQualityChanged();
+}
+
 bool BreezyDesktopEffect::removeVirtualDisplaysOnDisable() const {
     return m_removeVirtualDisplaysOnDisable;
 }
@@ -666,6 +2093,7 @@ void BreezyDesktopEffect::updatePose() {
     if (m_sessionClassBlocked) {
         return;
     }
+    BREEZY_TRACE_SCOPE("updatePose");
     // Reentrancy guard: if an update is already in progress, skip
     bool expected = false;
     if (!m_poseUpdateInProgress.compare_exchange_strong(expected, true)) {
@@ -682,10 +2110,17 @@ void BreezyDesktopEffect::updatePose() {
     }
     QByteArray buffer = shmFile.readAll();
     shmFile.close();
-    if (buffer.size() != DataView::LENGTH) return;
+    m_statistics.poseSamples.add();
+    if (buffer.size() != DataView::LENGTH) {
+        m_statistics.poseRejectedSize.add();
+        return;
+    }
 
     const char* data = buffer.constData();
-    if (!checkParityByte(data)) return;
+    if (!checkParityByte(data)) {
+        m_statistics.poseRejectedParity.add();
+        return;
+    }
 
     uint8_t version = static_cast<uint8_t>(data[DataView::VERSION[DataView::OFFSET_INDEX]]);
     uint8_t enabledFlag = static_cast<uint8_t>(data[DataView::ENABLED[DataView::OFFSET_INDEX]]);
@@ -735,6 +2170,8 @@ void BreezyDesktopEffect::updatePose() {
     const uint8_t expectedVersion = 5;
     bool enabledFlagSet = (enabledFlag != 0);
     bool validVersion = (version == expectedVersion);
+    // only samples that would have been used otherwise, a mismatched driver that isn't streaming isn't counted every poll
+    if (enabledFlagSet && validData && !validVersion) m_statistics.poseRejectedVersion.add();
     const bool wasEnabled = m_enabled;
     const bool enabled = enabledFlagSet && validVersion && validData;
     if (!enabled) {
@@ -759,6 +2196,7 @@ void BreezyDesktopEffect::updatePose() {
         activate();
         m_enabled = true;
         m_poseHasPosition = false;
+        BREEZY_TRACE_SCOPE("ipc: retrieve driver state");
         auto driverStateOpt = XRDriverIPC::instance().retrieveDriverState();
         if (driverStateOpt) {
             QJsonObject driverState = driverStateOpt.value();
@@ -785,6 +2223,12 @@ void BreezyDesktopEffect::updatePose() {
     m_poseResetState = (poseOrientationData[0] == 0.0f && poseOrientationData[1] == 0.0f && poseOrientationData[2] == 0.0f && poseOrientationData[3] == 1.0f);
     if (m_poseResetState != wasPoseResetState) {
         if (m_poseResetState) recenter();
+
+        // main.qml reacts to the signal synchronously, so anything it sets up is counted in
+        if (!m_poseResetState) {
+            m_poseResetEndedAt = steadyNow();
+            m_firstFrameAfterPoseResetPending = true;
+        }
         Q_EMIT poseResetStateChanged();
     }
 
@@ -808,6 +2252,14 @@ void BreezyDesktopEffect::updatePose() {
     // elapsed time between T0 and T1 is: poseOrientationData[0] - poseOrientationData[1]
     m_poseTimeElapsedMs = static_cast<quint32>(poseOrientationData[orientationDataOffset + 0] - poseOrientationData[orientationDataOffset + 1]);
 
+#ifdef BREEZY_DESKTOP_TRACING
+    if (poseDateMs != m_poseTimestamp) {
+        // a sample that's replaced before any frame used it ends here
+        if (m_tracedPoseTimestamp != 0) BREEZY_TRACE_ASYNC_END("pose", m_tracedPoseTimestamp);
+        BREEZY_TRACE_ASYNC_BEGIN("pose", poseDateMs);
+        m_tracedPoseTimestamp = poseDateMs;
+    }
+#endif
     m_poseTimestamp = poseDateMs;
     
     float originData[4 * DataView::POSE_ORIENTATION_ENTRIES]; // 4 quaternion-sized rows
@@ -848,6 +2300,8 @@ void BreezyDesktopEffect::updatePose() {
         Q_EMIT smoothFollowEnabledChanged();
         if (m_smoothFollowEnabled) updateDriverSmoothFollowSettings();
     }
+
+    if (m_enabled) requestRepaintIfPoseMoved();
 }
 
 void BreezyDesktopEffect::setSmoothFollowThreshold(float threshold) {
@@ -858,6 +2312,7 @@ void BreezyDesktopEffect::setSmoothFollowThreshold(float threshold) {
 }
 
 void BreezyDesktopEffect::updateDriverSmoothFollowSettings() {
+    BREEZY_TRACE_SCOPE("ipc: smooth follow settings");
     qreal adjustedDistance = m_focusedDisplayDistance / (m_displaySize * m_allDisplaysDistance);
 
     if (m_lookingAtScreenIndex != -1 && !m_displayResolution.isEmpty()) {
@@ -930,35 +2385,65 @@ void BreezyDesktopEffect::updateCursorImage()
         m_cursorImageSource = QString();
         m_cursorImageSize = QSize();
     }
+    m_cursorImage = cursor.image();
+    m_cursorHotSpot = cursor.hotSpot();
     // Cursor size affects the expanded geometry margin; invalidate cache.
     invalidateEffectOnScreenGeometryCache();
     Q_EMIT cursorImageSourceChanged();
 }
 
-void BreezyDesktopEffect::updateCursorPos()
+void BreezyDesktopEffect::cursorMoved(const QPointF &pos)
 {
-    // Update cursor position from effects
-    const auto cursor = effects->cursorImage();
-    QPointF newPos = effects->cursorPos() - cursor.hotSpot();
+    BREEZY_TRACE_SCOPE("cursorMoved");
+    // mouseChanged also fires for button and modifier changes, those don't carry any motion
+    const QPointF newPos = pos - m_cursorHotSpot;
+    if (m_cursorSample.timestamp != std::chrono::nanoseconds::zero() && m_cursorSample.pos == newPos) return;
+
+    m_prevCursorSample = m_cursorSample;
+    m_cursorSample = {newPos, steadyNow()};
+    m_cursorUpdatePending = true;
+    m_statistics.cursorUpdates.add();
+
+    // make sure a frame is coming, the hardware cursor plane alone won't trigger one
+    if (updateEffectOnScreenGeometryCache()) effects->addRepaint(m_effectOnScreenGeometry);
+}
+
+void BreezyDesktopEffect::updateCursorPos(std::chrono::nanoseconds targetTime)
+{
+    BREEZY_TRACE_SCOPE("updateCursorPos");
+    const QPointF newPos = m_cursorSample.pos;
     if (m_cursorPos != newPos) {
-        const QPointF prevPos = m_cursorPos;
         m_cursorPos = newPos;
         Q_EMIT cursorPosChanged();
+    }
+
+    evaluateCursorOnScreenState(newPos, predictCursorPos(targetTime));
+}
 
-        evaluateCursorOnScreenState(prevPos, m_cursorPos);
+QPointF BreezyDesktopEffect::predictCursorPos(std::chrono::nanoseconds targetTime) const
+{
+    const std::chrono::nanoseconds sampleInterval = m_cursorSample.timestamp - m_prevCursorSample.timestamp;
+    if (m_prevCursorSample.timestamp == std::chrono::nanoseconds::zero() ||
+        sampleInterval <= std::chrono::nanoseconds::zero() ||
+        sampleInterval > CURSOR_VELOCITY_MAX_INTERVAL) {
+        return m_cursorSample.pos;
     }
+
+    const std::chrono::nanoseconds horizon = std::clamp(
+        targetTime - m_cursorSample.timestamp,
+        std::chrono::nanoseconds::zero(),
+        CURSOR_PREDICTION_MAX_HORIZON);
+    const qreal scale = static_cast<qreal>(horizon.count()) / static_cast<qreal>(sampleInterval.count());
+    return m_cursorSample.pos + (m_cursorSample.pos - m_prevCursorSample.pos) * scale;
 }
 
-void BreezyDesktopEffect::evaluateCursorOnScreenState(const QPointF &prevPos, const QPointF &newPos)
+void BreezyDesktopEffect::evaluateCursorOnScreenState(const QPointF &pos, const QPointF &predictedPos)
 {
     if (!updateEffectOnScreenGeometryCache()) return;
 
-    const QPointF velocity = newPos - prevPos;
-    const QPointF predicted = newPos + velocity;
-
     const bool onScreen = 
-        m_effectOnScreenExpandedGeometry.contains(newPos.toPoint()) || 
-        m_effectOnScreenExpandedGeometry.contains(predicted.toPoint());
+        m_effectOnScreenExpandedGeometry.contains(pos.toPoint()) || 
+        m_effectOnScreenExpandedGeometry.contains(predictedPos.toPoint());
     if (m_enabled && !m_poseResetState && !m_cursorHidden && onScreen) {
         hideCursor();
     } else if (m_cursorHidden && (!m_enabled || m_poseResetState || !onScreen)) {
@@ -991,6 +2476,7 @@ bool BreezyDesktopEffect::updateEffectOnScreenGeometryCache()
     }
 
     const QRect geometry = effectOnScreen->geometry();
+    m_effectOnScreenGeometry = geometry;
     const int marginX = (m_cursorImageSize.width()  > 0) ? m_cursorImageSize.width()  : 10;
     const int marginY = (m_cursorImageSize.height() > 0) ? m_cursorImageSize.height() : 10;
     m_effectOnScreenExpandedGeometry = geometry.adjusted(-marginX, -marginY, marginX, marginY);
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "breezydesktopqualitygovernor.h"
+#include "breezydesktopstats.h"
+#include "breezydesktopvirtualoutputpool.h"
 #include "kcm/shortcuts.h"
 #include <effect/quickeffect.h>
 
@@ -9,10 +12,20 @@
 #include <QKeySequence>
 #include <QQuaternion>
 #include <QVariant>
+#include <QVector2D>
+#include <QVector3D>
 #include <QVariantList>
 #include <QHash>
 #include <QRect>
+#include <QRectF>
+#include <QSet>
+#include <QThreadPool>
+#include <QUrl>
 #include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+class QQmlComponent;
 class QTimer;
 
 namespace KWin
@@ -20,13 +33,16 @@ namespace KWin
     class BackendOutput;
     class LogicalOutput;
     class Output;
+    class BreezyDesktopNativeRenderer;
+    class BreezyDesktopScreenTextureCache;
+    class BreezyDesktopTimewarp;
 
 #if defined(KWIN_VERSION_ENCODED) && KWIN_VERSION_ENCODED >= 60590
     using ScreenOutput = LogicalOutput;
-    using VirtualOutputHandle = BackendOutput;
+    using PaintRegion = Region;
 #else
     using ScreenOutput = Output;
-    using VirtualOutputHandle = ScreenOutput;
+    using PaintRegion = QRegion;
 #endif
 
     class BreezyDesktopEffect : public QuickSceneEffect
@@ -62,11 +78,30 @@ namespace KWin
         Q_PROPERTY(QList<QQuaternion> smoothFollowOrigin READ smoothFollowOrigin)
         Q_PROPERTY(bool customBannerEnabled READ customBannerEnabled NOTIFY devicePropertiesChanged)
         Q_PROPERTY(int antialiasingQuality READ antialiasingQuality NOTIFY antialiasingQualityChanged)
+        Q_PROPERTY(int effectiveAntialiasingQuality READ effectiveAntialiasingQuality NOTIFY renderQualityChanged)
+        Q_PROPERTY(qreal renderScale READ renderScale NOTIFY renderQualityChanged)
         Q_PROPERTY(bool removeVirtualDisplaysOnDisable READ removeVirtualDisplaysOnDisable NOTIFY removeVirtualDisplaysOnDisableChanged)
         Q_PROPERTY(bool mirrorPhysicalDisplays READ mirrorPhysicalDisplays NOTIFY mirrorPhysicalDisplaysChanged)
         Q_PROPERTY(bool curvedDisplay READ curvedDisplay NOTIFY curvedDisplayChanged)
         Q_PROPERTY(bool curvedDisplaySupported READ curvedDisplaySupported WRITE setCurvedDisplaySupported NOTIFY curvedDisplaySupportedChanged)
         Q_PROPERTY(bool developerMode READ developerMode NOTIFY developerModeChanged)
+        Q_PROPERTY(bool lateLatchPose READ lateLatchPose NOTIFY lateLatchPoseChanged)
+        Q_PROPERTY(int renderBackend READ renderBackend NOTIFY renderBackendChanged)
+        Q_PROPERTY(int culledDisplayMask READ culledDisplayMask NOTIFY culledDisplayMaskChanged)
+        Q_PROPERTY(int displayTextureSource READ displayTextureSource NOTIFY displayTextureSourceChanged)
+        Q_PROPERTY(bool animationsActive READ animationsActive WRITE setAnimationsActive NOTIFY animationsActiveChanged)
+        Q_PROPERTY(bool instancedDisplays READ instancedDisplays NOTIFY instancedDisplaysChanged)
+        Q_PROPERTY(bool instancedDisplaysActive READ instancedDisplaysActive WRITE setInstancedDisplaysActive NOTIFY instancedDisplaysActiveChanged)
+        Q_PROPERTY(bool focusLodEnabled READ focusLodEnabled NOTIFY focusLodChanged)
+        Q_PROPERTY(qreal unfocusedTextureScale READ unfocusedTextureScale NOTIFY focusLodChanged)
+        Q_PROPERTY(bool distanceTextureScaling READ distanceTextureScaling NOTIFY focusLodChanged)
+        Q_PROPERTY(QObject *screenTextures READ screenTextures NOTIFY screenTexturesChanged)
+        Q_PROPERTY(QVariantMap textureUpdateRates READ textureUpdateRates NOTIFY textureUpdateRatesChanged)
+        Q_PROPERTY(QUrl assetsUrl READ assetsUrl CONSTANT)
+        Q_PROPERTY(QVector3D cameraEulerRotation READ cameraEulerRotation)
+        Q_PROPERTY(QQuaternion cameraOrientation READ cameraOrientation)
+        Q_PROPERTY(QVector3D cameraAngularRates READ cameraAngularRates)
+        Q_PROPERTY(QVariantMap hudStatistics READ hudStatistics NOTIFY hudStatisticsChanged)
 
 
     public:
@@ -77,6 +112,9 @@ namespace KWin
         void reconfigure(ReconfigureFlags) override;
 
         int requestedEffectChainPosition() const override;
+        void prePaintScreen(ScreenPrePaintData &data, std::chrono::milliseconds presentTime) override;
+        void paintScreen(const RenderTarget &renderTarget, const RenderViewport &viewport, int mask, const PaintRegion &region, ScreenOutput *screen) override;
+        void postPaintScreen() override;
 
         QString cursorImageSource() const;
         QSize cursorImageSize() const;
@@ -117,10 +155,31 @@ namespace KWin
         QList<QQuaternion> smoothFollowOrigin() const;
         bool customBannerEnabled() const;
         int antialiasingQuality() const;
+        int effectiveAntialiasingQuality() const;
+        qreal renderScale() const;
         bool removeVirtualDisplaysOnDisable() const;
         bool mirrorPhysicalDisplays() const;
         bool curvedDisplay() const;
         bool developerMode() const;
+        bool lateLatchPose() const;
+        int renderBackend() const;
+        int culledDisplayMask() const;
+        int displayTextureSource() const;
+        QVariantMap textureUpdateRates() const;
+        bool focusLodEnabled() const;
+        bool distanceTextureScaling() const;
+        qreal unfocusedTextureScale() const;
+        bool animationsActive() const;
+        void setAnimationsActive(bool active);
+        bool instancedDisplays() const;
+        bool instancedDisplaysActive() const;
+        void setInstancedDisplaysActive(bool active);
+        QObject *screenTextures() const;
+        QUrl assetsUrl() const;
+        QVector3D cameraEulerRotation() const;
+        QQuaternion cameraOrientation() const;
+        QVector3D cameraAngularRates() const;
+        QVariantMap hudStatistics() const;
         void setCurvedDisplaySupported(bool supported);
 
         void showCursor();
@@ -132,14 +191,28 @@ namespace KWin
         void enableDriver();
         void disableDriver();
         void toggle();
-        void addVirtualDisplay(QSize size);
+        void addVirtualDisplay(QSize size, qreal scale = 1.0, int textureUpdateRate = 0);
         void updatePose();
         void updateCursorImage();
-        void updateCursorPos();
+        void cursorMoved(const QPointF &pos);
         QVariantList listVirtualDisplays() const;
+        QVariantMap statistics() const;
         bool removeVirtualDisplay(const QString &id);
+        QStringList listVirtualDisplayLayouts() const;
+        bool saveVirtualDisplayLayout(const QString &name);
+        bool restoreVirtualDisplayLayout(const QString &name);
+        bool removeVirtualDisplayLayout(const QString &name);
+        bool applyVirtualDisplays(const QList<QVariantMap> &displays);
         void moveCursorToFocusedDisplay();
         bool curvedDisplaySupported() const;
+        void reportCameraPoseApplied(quint64 poseTimestamp);
+        void setNativeScene(const QVariantMap &scene);
+        void setCameraDistances(qreal lensDistancePixels, qreal fullScreenDistancePixels);
+        void setDisplayBounds(int index, const QVector3D &center, qreal radius);
+        void setDisplayMeshStats(int index, int vertexCount, qreal errorPixels);
+        void setDisplayPixelBudget(int index, qreal fullPixels, qreal renderedPixels, qreal visiblePixels);
+        void reportDisplayTextureUpdated();
+        void setHudRect(const QRectF &rect);
 
     Q_SIGNALS:
         void lookAheadOverrideChanged();
@@ -157,6 +230,7 @@ namespace KWin
         void smoothFollowEnabledChanged();
         void devicePropertiesChanged();
         void antialiasingQualityChanged();
+        void renderQualityChanged();
         void removeVirtualDisplaysOnDisableChanged();
         void mirrorPhysicalDisplaysChanged();
         void curvedDisplayChanged();
@@ -164,13 +238,45 @@ namespace KWin
         void developerModeChanged();
         void cursorImageSourceChanged();
         void cursorPosChanged();
+        void lateLatchPoseChanged();
+        void renderBackendChanged();
+        void culledDisplayMaskChanged();
+        void displayTextureSourceChanged();
+        void animationsActiveChanged();
+        void instancedDisplaysChanged();
+        void instancedDisplaysActiveChanged();
+        void focusLodChanged();
+        void hudStatisticsChanged();
+
+        // emitted before the scene renders with the Workspace.screens indices whose contents changed since the last frame
+        void screenContentsDamaged(const QList<int> &screenIndices);
+        void screenTexturesChanged();
+        void textureUpdateRatesChanged();
+
+        // emitted just before the scene is rendered, camera* properties hold the newest predicted pose
+        void cameraPoseLatched();
 
     protected:
         QVariantMap initialProperties(ScreenOutput *screen) override;
 
     private:
+        // a look-ahead prediction from the newest pose samples, see predictCameraPose()
+        struct CameraPose {
+            QVector3D eulerRotation;
+            QQuaternion orientation;
+            QVector3D angularRates; // radians per ms (pitch, yaw, roll)
+            float lookAheadMs = 0.0f;
+        };
+
         void teardown();
         bool checkParityByte(const char* data);
+        void registerShortcuts();
+        void initializeDeferred();
+        void prewarmScene();
+        bool applyVirtualDisplayPlacements(const QList<BreezyDesktopVirtualOutputPool::Placement> &placements,
+                                           const QString &description);
+        void persistVirtualDisplays();
+        void applyVirtualDisplayTextureUpdateRates();
         void setupGlobalShortcut(const BreezyShortcuts::Shortcut &shortcut, 
                                  std::function<void()> triggeredFunc);
         void recenter();
@@ -178,9 +284,41 @@ namespace KWin
         void setSmoothFollowThreshold(float threshold);
         void updateDriverSmoothFollowSettings();
         void warpPointerToOutputCenter(ScreenOutput *output);
-        void evaluateCursorOnScreenState(const QPointF &prevPos, const QPointF &newPos);
+        void updateCursorPos(std::chrono::nanoseconds targetTime);
+        QPointF predictCursorPos(std::chrono::nanoseconds targetTime) const;
+        void evaluateCursorOnScreenState(const QPointF &pos, const QPointF &predictedPos);
         void invalidateEffectOnScreenGeometryCache();
         bool updateEffectOnScreenGeometryCache();
+        std::optional<CameraPose> predictCameraPose() const;
+        bool latchCameraPose();
+        bool timewarpActive() const;
+        bool nativeBackendActive() const;
+        void paintTimewarp(const RenderTarget &renderTarget, const RenderViewport &viewport, int mask, const PaintRegion &region, ScreenOutput *screen);
+        bool paintNative(const RenderViewport &viewport);
+        QVector3D cameraPosition() const;
+        QVector3D cameraPosition(const QQuaternion &orientation) const;
+        void updateDisplayCulling();
+        void updateDisplayTextures();
+        bool poseMovedSinceRender(const CameraPose &pose) const;
+        void requestRepaintIfPoseMoved();
+        QVector2D fovHalfTangents() const;
+        void recordPoseSubmitted();
+        void reportFrameStatistics();
+        void reportFrameCost();
+        void reportTimewarpStatistics();
+        void reportCullingStatistics();
+        void reportDisplayMeshStatistics();
+        void reportScreenTextureStatistics();
+        void reportRenderQuality();
+        void reportRepaintSuppression();
+        void reportFocusLodStatistics();
+        void reportDisplayTextureUpdates();
+        bool autoQualityActive() const;
+        void updateRenderQuality(double frameCostMs);
+        void updateHudTimer();
+        void resetHudWindow();
+        quint64 rejectedPoseSamples() const;
+        void updateHudStatistics();
 
         QString m_cursorImageSource;
         QSize m_cursorImageSize;
@@ -208,7 +346,16 @@ namespace KWin
         QFileSystemWatcher *m_shmDirectoryWatcher = nullptr;
         bool m_cursorHidden = false;
         QPointF m_cursorPos;
-        QTimer *m_cursorUpdateTimer = nullptr;
+        QPointF m_cursorHotSpot;
+
+        // Pointer motion samples, timestamped on arrival (steady clock, same base as presentTime)
+        struct CursorSample {
+            QPointF pos;
+            std::chrono::nanoseconds timestamp{0};
+        };
+        CursorSample m_cursorSample;
+        CursorSample m_prevCursorSample;
+        bool m_cursorUpdatePending = false;
         QTimer *m_watchdogTimer = nullptr;
         std::atomic<bool> m_poseUpdateInProgress{false};
         bool m_sessionClassBlocked = false;
@@ -219,26 +366,184 @@ namespace KWin
         qreal m_displayHorizontalOffset = 0.0;
         qreal m_displayVerticalOffset = 0.0;
         int m_displayWrappingScheme = 0; // 0=auto,1=horizontal,2=vertical,3=flat
-        int m_antialiasingQuality = 3; // 0=None, 1=Medium, 2=High, 3=VeryHigh
+        int m_antialiasingQuality = 3; // 0=None, 1=Medium, 2=High, 3=VeryHigh, 4=Auto
         bool m_removeVirtualDisplaysOnDisable = true;
         bool m_mirrorPhysicalDisplays = false;
         bool m_curvedDisplay = false;
         bool m_curvedDisplaySupported = false;
         bool m_developerMode = false;
+        bool m_lateLatchPose = true;
+        bool m_timewarpEnabled = false;
+        int m_timewarpSceneFrameDivider = 1;
+        int m_renderBackend = 0; // 0=QtQuick3D, 1=Native OpenGL
+        bool m_displayCulling = true;
+        bool m_repaintSuppression = true;
+        bool m_focusLodEnabled = true;
+        qreal m_unfocusedTextureScale = 0.5;
+        bool m_distanceTextureScaling = false;
+        bool m_animationsActive = false;
+        int m_displayTextureSource = 1; // 0=Window thumbnails, 1=Output textures
+        bool m_instancedDisplays = true;
+        bool m_instancedDisplaysActive = false; // set by BreezyDesktop.qml when the scene actually uses the instanced path
         float m_smoothFollowThreshold = 1.0f;
         bool m_allDisplaysFollowMode = false;
         bool m_focusedSmoothFollowEnabled = false;
 
+        // Camera pose as latched in prePaintScreen, rates are in radians per ms (pitch, yaw, roll)
+        QVector3D m_cameraEulerRotation;
+        QQuaternion m_cameraOrientation;
+        QVector3D m_cameraAngularRates;
+        std::chrono::nanoseconds m_smoothFollowDisablingUntil{0};
+        bool m_paintingEffectScreen = false;
+
+        // Pose age instrumentation, the camera's pose timestamp (wall clock ms) and when it was applied (steady clock)
+        quint64 m_appliedPoseTimestamp = 0;
+        std::chrono::nanoseconds m_cameraAppliedAt{0};
+        BreezyStats::RunningStat m_poseAgeAtSubmit;
+        BreezyStats::RunningStat m_applyToSubmit;
+
+        // Timewarp: reprojects the last scene frame when the scene render is skipped (too slow, or forced via the divider)
+        std::unique_ptr<BreezyDesktopTimewarp> m_timewarp;
+        std::chrono::nanoseconds m_frameInterval{0};
+        std::chrono::nanoseconds m_lastSceneRenderCost{0};
+        quint64 m_timewarpFrameCount = 0;
+        quint64 m_timewarpFrames = 0; // since the last report, like m_timewarpReprojectedFrames
+        quint64 m_timewarpReprojectedFrames = 0;
+        bool m_timewarpSkipNextScene = false;
+        bool m_timewarpReprojecting = false; // this frame's scene wasn't rendered, see prePaintScreen
+        QQuaternion m_timewarpRenderedOrientation;
+        QQuaternion m_timewarpPresentedOrientation;
+        bool m_timewarpPresentedValid = false;
+        BreezyStats::RunningStat m_timewarpResidualError; // degrees, presented orientation vs. next pose sample
+        BreezyStats::RunningStat m_timewarpStaleError;    // degrees, same comparison without the reprojection
+
+        // Native OpenGL backend, scene description comes from NativeDisplays.qml
+        std::unique_ptr<BreezyDesktopNativeRenderer> m_nativeRenderer;
+
+        // Per-screen textures, sampled by the native backend and by OutputTexture items in the QtQuick3D scene
+        std::unique_ptr<BreezyDesktopScreenTextureCache> m_screenTextures;
+        QVariantMap m_textureUpdateRates; // virtual display id (screen name) -> texture update cap in Hz, if it has one
+
+        // Display texture updates performed vs. skipped for lack of damage, summed over displays and frames
+        quint64 m_displayTextureUpdates = 0;
+        quint64 m_displayTextureUpdatesSkipped = 0;
+        int m_displayTextureUpdatesThisFrame = 0;
+        QSet<ScreenOutput *> m_previouslyDamagedScreens;
+        qreal m_cameraLensDistancePixels = 0.0;
+        qreal m_cameraFullScreenDistancePixels = 0.0;
+
+        // Frustum culling: bounding spheres reported by the display delegates, bit N set = display N culled.
+        // Only the first 31 displays can be culled since the mask has to survive QML's 32-bit bitwise ops.
+        struct DisplayBounds {
+            QVector3D center;
+            qreal radius = -1.0;
+        };
+        QList<DisplayBounds> m_displayBounds;
+        // Curved mesh tessellation per display as reported by the delegates in developer mode, vertexCount -1 = gone
+        struct DisplayMeshStats {
+            int vertexCount = -1;
+            qreal errorPixels = 0.0;
+        };
+        QList<DisplayMeshStats> m_displayMeshStats;
+        // Texture pixels per display in developer mode: at full resolution, as rendered after LOD and distance scaling,
+        // and what the glasses can show of it; fullPixels -1 = gone
+        struct DisplayPixelBudget {
+            qreal fullPixels = -1.0;
+            qreal renderedPixels = 0.0;
+            qreal visiblePixels = 0.0;
+        };
+        QList<DisplayPixelBudget> m_displayPixelBudgets;
+        int m_culledDisplayMask = 0;
+        BreezyStats::RunningStat m_culledDisplays; // per frame
+        QImage m_cursorImage;
+
+        // Static pose repaint suppression: the camera pose of the last rendered frame, compared against new pose samples
+        QQuaternion m_renderedCameraRotation;
+        QVector3D m_renderedCameraPosition;
+        bool m_renderedPoseValid = false;
+        quint64 m_poseSamples = 0;
+        quint64 m_poseSamplesSuppressed = 0;
+
+        BreezyStats::RunningStat m_paintTime; // ms from prePaintScreen to postPaintScreen for the XR screen
+        std::chrono::nanoseconds m_frameStart{0};
+
+        // Cumulative since the effect was loaded, for statistics(). Recorded from the paint path, the pose file watcher
+        // and the IPC worker thread, so lock-free and always on.
+        struct RuntimeStatistics {
+            BreezyStats::AtomicCounter poseSamples;
+            BreezyStats::AtomicCounter poseRejectedSize;
+            BreezyStats::AtomicCounter poseRejectedParity;
+            BreezyStats::AtomicCounter poseRejectedVersion; // polls of an enabled, live sample with another layout version
+            BreezyStats::AtomicHistogram poseAgeAtRender; // ms
+            BreezyStats::AtomicHistogram frameTime;       // ms, prePaintScreen to postPaintScreen for the XR screen
+            BreezyStats::AtomicCounter cursorUpdates;
+            BreezyStats::AtomicCounter ipcCalls;
+            BreezyStats::AtomicCounter ipcFailures;
+            BreezyStats::AtomicHistogram ipcLatency{1.0}; // ms, from 1ms so the driver's 5s and 15s timeouts fit
+        };
+        RuntimeStatistics m_statistics;
+
+        // Developer mode HUD (DeveloperHud.qml): what happened since the last refresh, turned into hudStatistics and
+        // reset every HUD_UPDATE_INTERVAL. The timer only runs while the effect is enabled in developer mode.
+        struct HudWindow {
+            BreezyStats::RunningStat frameTime; // ms
+            BreezyStats::RunningStat poseAge;   // ms, at submit
+            BreezyStats::RunningStat lookAhead; // ms the camera pose was predicted ahead by
+            quint64 poseSamples = 0;            // m_statistics.poseSamples when the window started
+            quint64 rejectedSamples = 0;        // rejectedPoseSamples() when the window started
+            std::chrono::nanoseconds startedAt{0};
+        };
+        HudWindow m_hudWindow;
+        QTimer *m_hudTimer = nullptr;
+        // where DeveloperHud.qml draws, relative to the effect screen; head-locked, so timewarp leaves it unrotated
+        QRectF m_hudRect;
+        QVariantMap m_hudStatistics;
+
+#ifdef BREEZY_DESKTOP_TRACING
+        quint64 m_tracedPoseTimestamp = 0; // pose sample whose "pose" async slice is open, see breezydesktoptrace.h
+#endif
+
+        // set once the driver's IMU file has appeared or the effect was activated, see initializeDeferred()
+        bool m_deferredInitialized = false;
+        // driver calls that can block for seconds, waited on by the destructor so none outlive the effect
+        QThreadPool m_ipcThreadPool;
+
+        // Activation latency: scene source (compiled in or from disk), whether its QML was compiled ahead of time,
+        // and the time from activate() to the end of the first XR frame
+        QUrl m_sceneSource;
+        std::unique_ptr<QQmlComponent> m_prewarmComponent;
+        bool m_scenePrewarmed = false;
+        std::chrono::nanoseconds m_activatedAt{0};
+        bool m_firstFrameAfterActivationPending = false;
+        double m_sceneInstantiationMs = 0.0;
+
+        // time from the end of a pose reset (recenter, calibration) to the end of the first XR frame painted after it
+        std::chrono::nanoseconds m_poseResetEndedAt{0};
+        bool m_firstFrameAfterPoseResetPending = false;
+        BreezyStats::RunningStat m_firstFrameAfterPoseReset; // ms, kept for the whole session
+
+        // Auto antialiasing: the governor steps SSAA and render scale to hold the refresh rate
+        BreezyDesktopQualityGovernor m_qualityGovernor;
+        BreezyDesktopQualityGovernor::Level m_renderQuality{3, 1.0};
+        std::chrono::milliseconds m_presentTime{0};
+        std::chrono::milliseconds m_lastPresentTime{0};
+        bool m_continuousRepaintRequested = false;
+        quint64 m_qualityChanges = 0;
+        std::chrono::nanoseconds m_poseStatsReportedAt{0};
+        std::chrono::nanoseconds m_frameStatsReportedAt{0};
+
         // Cached geometry for on-screen cursor evaluation
+        QRect m_effectOnScreenGeometry;
         QRect m_effectOnScreenExpandedGeometry;
         bool m_effectOnScreenGeometryValid = false;
 
-        struct VirtualOutputInfo {
-            VirtualOutputHandle *output = nullptr;
-            QString id;
-            QSize size;
-        };
-        QHash<QString, VirtualOutputInfo> m_virtualDisplays;
+        BreezyDesktopVirtualOutputPool m_virtualOutputs;
+        bool m_virtualDisplaysRestored = false; // the "current" saved layout, once per session
+
+        // KWin output layout changes (outputs added, removed or moved), each one re-places the windows; sampled on
+        // toggle so the activation log can tell how many a disable/enable cycle cost
+        quint64 m_outputLayoutChanges = 0;
+        quint64 m_outputLayoutChangesAtDeactivate = 0;
     };
 
 } // namespace KWin
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "opengl/openglcontext.h"
+
+#include <QByteArray>
+
+namespace KWin
+{
+namespace BreezyGlsl
+{
+    // Puts the #version line in front of a shader written against GLSL 1.40 (in/out, texture() and a declared
+    // fragment output), picked for the current context the way KWin's ShaderManager does for its own shaders:
+    // 1.40 on desktop GL, 3.00 es on GLES. The scene needs QtQuick3D, which needs GLES 3 anyway.
+    inline QByteArray versioned(const QByteArray &source)
+    {
+        const OpenGlContext *context = OpenGlContext::currentContext();
+        if (context && context->isOpenGLES()) {
+            return QByteArrayLiteral("#version 300 es\nprecision highp float;\n") + source;
+        }
+        return QByteArrayLiteral("#version 140\n") + source;
+    }
+} // namespace BreezyGlsl
+} // namespace KWin
@@ -0,0 +1,197 @@
+#include "breezydesktopnativerenderer.h"
+#include "breezydesktopglsl.h"
+#include "breezydesktopscreentexturecache.h"
+
+#include "core/output.h"
+#include "core/renderviewport.h"
+#include "effect/effecthandler.h"
+#include "opengl/glutils.h"
+
+#include <QLoggingCategory>
+#include <QVector4D>
+
+#include <array>
+
+Q_DECLARE_LOGGING_CATEGORY(KWIN_XR)
+
+namespace
+{
+    // versioned for the context in ensureShader()
+    const QByteArray DISPLAY_VERTEX_SHADER = QByteArrayLiteral(R"(
+uniform mat4 modelViewProjectionMatrix;
+
+in vec4 position;
+in vec4 texcoord;
+
+out vec2 texcoord0;
+
+void main()
+{
+    texcoord0 = texcoord.xy;
+    gl_Position = modelViewProjectionMatrix * vec4(position.xyz, 1.0);
+}
+)");
+
+    // GL port of cursorOverlay.frag; screen textures are bottom-up so v already points up like the mesh's t
+    const QByteArray DISPLAY_FRAGMENT_SHADER = QByteArrayLiteral(R"(
+uniform sampler2D sampler;
+uniform sampler2D cursorSampler;
+uniform vec4 cursorRect; // x, y, width, height relative to the screen, top-left origin
+uniform int showCursor;
+
+in vec2 texcoord0;
+out vec4 fragColor;
+
+void main()
+{
+    vec4 color = texture(sampler, texcoord0);
+    if (showCursor != 0) {
+        vec2 screenCoord = vec2(texcoord0.x, 1.0 - texcoord0.y);
+        vec2 rel = (screenCoord - cursorRect.xy) / cursorRect.zw;
+        if (all(greaterThanEqual(rel, vec2(0.0))) && all(lessThan(rel, vec2(1.0)))) {
+            vec4 cursorColor = texture(cursorSampler, rel);
+            color = mix(color, cursorColor, cursorColor.a);
+        }
+    }
+    fragColor = color;
+}
+)");
+
+    constexpr int FLOATS_PER_VERTEX = 5;
+}
+
+namespace KWin
+{
+
+BreezyDesktopNativeRenderer::BreezyDesktopNativeRenderer() = default;
+
+BreezyDesktopNativeRenderer::~BreezyDesktopNativeRenderer() = default;
+
+void BreezyDesktopNativeRenderer::setDisplays(const QList<Display> &displays)
+{
+    m_displays = displays;
+    m_buffersDirty = true;
+}
+
+bool BreezyDesktopNativeRenderer::ensureShader()
+{
+    if (m_shader) return true;
+    if (m_shaderFailed) return false;
+
+    m_shader = ShaderManager::instance()->generateCustomShader(ShaderTrait::MapTexture,
+                                                                BreezyGlsl::versioned(DISPLAY_VERTEX_SHADER),
+                                                                BreezyGlsl::versioned(DISPLAY_FRAGMENT_SHADER));
+    if (!m_shader || !m_shader->isValid()) {
+        qCWarning(KWIN_XR) << "\t\t\tBreezy - native display shader failed to compile";
+        m_shader.reset();
+        m_shaderFailed = true;
+        return false;
+    }
+    return true;
+}
+
+void BreezyDesktopNativeRenderer::uploadBuffers()
+{
+    static constexpr std::array<GLVertexAttrib, 2> layout{{
+        {.attributeIndex = VA_Position, .componentCount = 3, .type = GL_FLOAT, .relativeOffset = 0},
+        {.attributeIndex = VA_TexCoord, .componentCount = 2, .type = GL_FLOAT, .relativeOffset = 3 * sizeof(float)},
+    }};
+
+    m_buffers.clear();
+    for (const Display &display : std::as_const(m_displays)) {
+        auto buffer = std::make_unique<GLVertexBuffer>(GLVertexBuffer::Static);
+        buffer->setAttribLayout(std::span(layout), FLOATS_PER_VERTEX * sizeof(float));
+        buffer->setData(display.vertices.data(), display.vertices.size() * sizeof(float));
+        buffer->setVertexCount(display.vertices.size() / FLOATS_PER_VERTEX);
+        m_buffers.push_back(std::move(buffer));
+    }
+    m_buffersDirty = false;
+}
+
+void BreezyDesktopNativeRenderer::updateCursorTexture(const QImage &image)
+{
+    if (image.isNull()) {
+        m_cursorTexture.reset();
+        m_cursorImageKey = 0;
+        return;
+    }
+    if (m_cursorTexture && m_cursorImageKey == image.cacheKey()) return;
+
+    m_cursorTexture = GLTexture::upload(image);
+    if (m_cursorTexture) {
+        m_cursorTexture->setFilter(GL_LINEAR);
+        m_cursorTexture->setWrapMode(GL_CLAMP_TO_EDGE);
+    }
+    m_cursorImageKey = image.cacheKey();
+}
+
+bool BreezyDesktopNativeRenderer::paint(const RenderViewport &viewport,
+                                        const QMatrix4x4 &viewProjection,
+                                        BreezyDesktopScreenTextureCache &textures,
+                                        const Cursor &cursor,
+                                        int culledMask)
+{
+    if (m_displays.isEmpty() || !ensureShader()) return false;
+    if (m_buffersDirty) uploadBuffers();
+    updateCursorTexture(cursor.image);
+
+    // screen textures are rendered into their own framebuffers, do it before the output's target is bound for drawing
+    const auto screens = effects->screens();
+    std::vector<GLTexture *> screenTextures;
+    screenTextures.reserve(m_displays.size());
+    for (int i = 0; i < m_displays.size(); ++i) {
+        const Display &display = m_displays.at(i);
+        const bool culled = i < 31 && (culledMask & (1 << i));
+        ScreenOutput *screen = !culled && display.screenIndex >= 0 && display.screenIndex < screens.size() ? screens.at(display.screenIndex) : nullptr;
+        screenTextures.push_back(textures.texture(screen, viewport.scale()));
+    }
+
+    glClearColor(0.0, 0.0, 0.0, 1.0);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glDisable(GL_BLEND);
+
+    ShaderManager::instance()->pushShader(m_shader.get());
+    m_shader->setUniform("sampler", 0);
+    m_shader->setUniform("cursorSampler", 1);
+
+    if (m_cursorTexture) {
+        glActiveTexture(GL_TEXTURE1);
+        m_cursorTexture->bind();
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    // no depth buffer on the output; displays don't overlap in any of the wrapping schemes, so draw order doesn't matter
+    for (size_t i = 0; i < m_buffers.size(); ++i) {
+        GLTexture *texture = screenTextures[i];
+        if (!texture) continue;
+
+        const auto &display = m_displays.at(i);
+        ScreenOutput *screen = screens.at(display.screenIndex);
+        const QRectF screenGeometry = screen->geometry();
+        const bool showCursor = m_cursorTexture && cursor.rect.intersects(screenGeometry);
+        m_shader->setUniform("showCursor", showCursor ? 1 : 0);
+        if (showCursor) {
+            m_shader->setUniform("cursorRect", QVector4D(
+                (cursor.rect.x() - screenGeometry.x()) / screenGeometry.width(),
+                (cursor.rect.y() - screenGeometry.y()) / screenGeometry.height(),
+                cursor.rect.width() / screenGeometry.width(),
+                cursor.rect.height() / screenGeometry.height()));
+        }
+
+        m_shader->setUniform(GLShader::Mat4Uniform::ModelViewProjectionMatrix, viewProjection * display.model);
+        texture->bind();
+        m_buffers[i]->render(GL_TRIANGLE_STRIP);
+        texture->unbind();
+    }
+
+    if (m_cursorTexture) {
+        glActiveTexture(GL_TEXTURE1);
+        m_cursorTexture->unbind();
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    ShaderManager::instance()->popShader();
+    return true;
+}
+
+} // namespace KWin
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QImage>
+#include <QList>
+#include <QMatrix4x4>
+#include <QRectF>
+
+#include <memory>
+#include <vector>
+
+namespace KWin
+{
+    class BreezyDesktopScreenTextureCache;
+    class GLShader;
+    class GLTexture;
+    class GLVertexBuffer;
+    class RenderViewport;
+
+    // Draws the display meshes straight into the output with KWin's GL helpers, no QtQuick3D scene involved.
+    // Placements and meshes still come from the QML side (see NativeDisplays.qml), the camera from the effect.
+    class BreezyDesktopNativeRenderer
+    {
+    public:
+        struct Display {
+            int screenIndex = -1;
+            QMatrix4x4 model;
+            std::vector<float> vertices; // triangle strip, x, y, z, u, v per vertex
+        };
+
+        struct Cursor {
+            QImage image;
+            QRectF rect; // global logical coordinates
+        };
+
+        BreezyDesktopNativeRenderer();
+        ~BreezyDesktopNativeRenderer();
+
+        void setDisplays(const QList<Display> &displays);
+
+        // returns false if nothing could be drawn and the caller should fall back,
+        // displays with their bit set in culledMask are neither drawn nor have their textures updated
+        bool paint(const RenderViewport &viewport,
+                   const QMatrix4x4 &viewProjection,
+                   BreezyDesktopScreenTextureCache &textures,
+                   const Cursor &cursor,
+                   int culledMask);
+
+    private:
+        bool ensureShader();
+        void uploadBuffers();
+        void updateCursorTexture(const QImage &image);
+
+        QList<Display> m_displays;
+        std::vector<std::unique_ptr<GLVertexBuffer>> m_buffers;
+        bool m_buffersDirty = false;
+
+        std::unique_ptr<GLShader> m_shader;
+        bool m_shaderFailed = false;
+
+        std::unique_ptr<GLTexture> m_cursorTexture;
+        qint64 m_cursorImageKey = 0;
+    };
+
+} // namespace KWin
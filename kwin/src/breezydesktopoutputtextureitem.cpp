@@ -0,0 +1,295 @@
+#include "breezydesktopoutputtextureitem.h"
+#include "breezydesktopscreentexturecache.h"
+
+#include "core/output.h"
+#include "opengl/glutils.h"
+
+#include <QQuickWindow>
+#include <QRunnable>
+#include <QSGImageNode>
+#include <QSGTextureProvider>
+
+#include <memory>
+#include <utility>
+
+namespace KWin
+{
+
+class BreezyDesktopOutputTextureProvider : public QSGTextureProvider
+{
+public:
+    explicit BreezyDesktopOutputTextureProvider(QQuickWindow *window)
+        : m_window(window)
+    {
+    }
+
+    QSGTexture *texture() const override
+    {
+        return m_texture.get();
+    }
+
+    void setTexture(GLTexture *nativeTexture, bool mipmaps)
+    {
+        // same GL texture with new contents doesn't need a new wrapper, but consumers still need to know
+        if (!m_texture || m_nativeTexture != nativeTexture->texture() || m_texture->textureSize() != nativeTexture->size() || m_mipmaps != mipmaps) {
+            m_nativeTexture = nativeTexture->texture();
+            m_mipmaps = mipmaps;
+            QQuickWindow::CreateTextureOptions options = QQuickWindow::TextureIsOpaque;
+            if (mipmaps) options |= QQuickWindow::TextureHasMipmaps;
+            m_texture.reset(QNativeInterface::QSGOpenGLTexture::fromNative(m_nativeTexture, m_window, nativeTexture->size(), options));
+            m_texture->setFiltering(QSGTexture::Linear);
+            m_texture->setMipmapFiltering(mipmaps ? QSGTexture::Linear : QSGTexture::None);
+        }
+        Q_EMIT textureChanged();
+    }
+
+private:
+    QQuickWindow *m_window;
+    GLuint m_nativeTexture = 0;
+    bool m_mipmaps = false;
+    std::unique_ptr<QSGTexture> m_texture;
+};
+
+namespace
+{
+    // the provider's QSGTexture belongs to the scene graph, so it has to go away on the render side
+    class ProviderCleanupJob : public QRunnable
+    {
+    public:
+        explicit ProviderCleanupJob(QObject *object)
+            : m_object(object)
+        {
+        }
+
+        void run() override
+        {
+            delete m_object;
+        }
+
+    private:
+        QObject *m_object;
+    };
+}
+
+BreezyDesktopOutputTextureItem::BreezyDesktopOutputTextureItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents);
+}
+
+BreezyDesktopOutputTextureItem::~BreezyDesktopOutputTextureItem()
+{
+    if (m_acquiredCache) {
+        m_acquiredCache->release(m_acquiredScreen);
+        if (!m_acquiredAtlasScreens.isEmpty()) m_acquiredCache->setAtlasScreens({});
+    }
+    destroyProvider();
+}
+
+QObject *BreezyDesktopOutputTextureItem::screen() const
+{
+    return m_screen;
+}
+
+void BreezyDesktopOutputTextureItem::setScreen(QObject *screen)
+{
+    ScreenOutput *output = qobject_cast<ScreenOutput *>(screen);
+    if (m_screen == output) return;
+
+    m_screen = output;
+    updateAcquired();
+    update();
+    Q_EMIT screenChanged();
+}
+
+QObject *BreezyDesktopOutputTextureItem::textureCache() const
+{
+    return m_cache;
+}
+
+void BreezyDesktopOutputTextureItem::setTextureCache(QObject *textureCache)
+{
+    BreezyDesktopScreenTextureCache *cache = qobject_cast<BreezyDesktopScreenTextureCache *>(textureCache);
+    if (m_cache == cache) return;
+
+    if (m_cache) disconnect(m_cache, nullptr, this, nullptr);
+    m_cache = cache;
+    if (m_cache) {
+        connect(m_cache, &BreezyDesktopScreenTextureCache::textureUpdated, this, [this](ScreenOutput *screen) {
+            if (screen == m_screen && m_atlasScreens.isEmpty()) update();
+        });
+        connect(m_cache, &BreezyDesktopScreenTextureCache::atlasUpdated, this, [this]() {
+            if (!m_atlasScreens.isEmpty()) update();
+        });
+        connect(m_cache, &BreezyDesktopScreenTextureCache::atlasLayoutChanged, this, &BreezyDesktopOutputTextureItem::updateAtlasRects);
+    }
+
+    updateAcquired();
+    updateAtlasRects();
+    update();
+    Q_EMIT textureCacheChanged();
+}
+
+qreal BreezyDesktopOutputTextureItem::textureScale() const
+{
+    return m_textureScale;
+}
+
+void BreezyDesktopOutputTextureItem::setTextureScale(qreal scale)
+{
+    if (qFuzzyCompare(m_textureScale, scale)) return;
+
+    m_textureScale = scale;
+    updateAcquired();
+    Q_EMIT textureScaleChanged();
+}
+
+bool BreezyDesktopOutputTextureItem::mipmaps() const
+{
+    return m_mipmaps;
+}
+
+void BreezyDesktopOutputTextureItem::setMipmaps(bool mipmaps)
+{
+    if (m_mipmaps == mipmaps) return;
+
+    m_mipmaps = mipmaps;
+    updateAcquired();
+    Q_EMIT mipmapsChanged();
+}
+
+QVariantList BreezyDesktopOutputTextureItem::atlasScreens() const
+{
+    QVariantList screens;
+    for (const QPointer<ScreenOutput> &screen : m_atlasScreens) {
+        screens.append(QVariant::fromValue<QObject *>(screen.data()));
+    }
+    return screens;
+}
+
+void BreezyDesktopOutputTextureItem::setAtlasScreens(const QVariantList &screens)
+{
+    QList<QPointer<ScreenOutput>> atlasScreens;
+    for (const QVariant &screen : screens) {
+        if (ScreenOutput *output = qobject_cast<ScreenOutput *>(screen.value<QObject *>())) atlasScreens.append(output);
+    }
+    if (m_atlasScreens == atlasScreens) return;
+
+    m_atlasScreens = atlasScreens;
+    updateAcquired();
+    updateAtlasRects();
+    update();
+    Q_EMIT atlasScreensChanged();
+}
+
+QVariantList BreezyDesktopOutputTextureItem::atlasRects() const
+{
+    return m_atlasRects;
+}
+
+void BreezyDesktopOutputTextureItem::updateAtlasRects()
+{
+    QVariantList rects;
+    for (const QPointer<ScreenOutput> &screen : std::as_const(m_atlasScreens)) {
+        rects.append(m_cache ? m_cache->atlasRect(screen) : QRectF());
+    }
+    if (m_atlasRects == rects) return;
+
+    m_atlasRects = rects;
+    Q_EMIT atlasRectsChanged();
+}
+
+void BreezyDesktopOutputTextureItem::updateAcquired()
+{
+    // culled (invisible) displays keep their last texture but stop re-rendering it
+    QList<ScreenOutput *> atlasScreens;
+    if (isVisible()) {
+        for (const QPointer<ScreenOutput> &screen : std::as_const(m_atlasScreens)) {
+            if (screen) atlasScreens.append(screen);
+        }
+    }
+    ScreenOutput *screen = isVisible() && atlasScreens.isEmpty() ? m_screen.data() : nullptr;
+    BreezyDesktopScreenTextureCache *cache = screen || !atlasScreens.isEmpty() ? m_cache.data() : nullptr;
+    if (!cache) atlasScreens.clear();
+    if (m_acquiredCache == cache && m_acquiredScreen == screen && m_acquiredAtlasScreens == atlasScreens &&
+        m_acquiredTextureScale == m_textureScale && m_acquiredMipmaps == m_mipmaps) return;
+
+    // the atlas is only touched by items that use it, there's just one per cache
+    const bool hadAtlas = !m_acquiredAtlasScreens.isEmpty();
+    if (m_acquiredCache) {
+        m_acquiredCache->release(m_acquiredScreen);
+        if (hadAtlas && (m_acquiredCache != cache || atlasScreens.isEmpty())) m_acquiredCache->setAtlasScreens({});
+    }
+    m_acquiredCache = cache;
+    m_acquiredScreen = cache ? screen : nullptr;
+    m_acquiredAtlasScreens = atlasScreens;
+    m_acquiredTextureScale = m_textureScale;
+    m_acquiredMipmaps = m_mipmaps;
+    if (!m_acquiredCache) return;
+
+    if (m_acquiredScreen) m_acquiredCache->acquire(m_acquiredScreen, m_textureScale, m_mipmaps);
+    if (!m_acquiredAtlasScreens.isEmpty()) m_acquiredCache->setAtlasScreens(m_acquiredAtlasScreens);
+}
+
+void BreezyDesktopOutputTextureItem::itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &value)
+{
+    if (change == QQuickItem::ItemVisibleHasChanged) updateAcquired();
+    if (change == QQuickItem::ItemSceneChange && !value.window) destroyProvider();
+    QQuickItem::itemChange(change, value);
+}
+
+bool BreezyDesktopOutputTextureItem::isTextureProvider() const
+{
+    return true;
+}
+
+QSGTextureProvider *BreezyDesktopOutputTextureItem::textureProvider() const
+{
+    if (QQuickItem::isTextureProvider()) return QQuickItem::textureProvider();
+    if (!m_provider) m_provider = new BreezyDesktopOutputTextureProvider(window());
+    return m_provider;
+}
+
+QSGNode *BreezyDesktopOutputTextureItem::updatePaintNode(QSGNode *oldNode, QQuickItem::UpdatePaintNodeData *)
+{
+    const bool atlas = !m_atlasScreens.isEmpty();
+    GLTexture *texture = nullptr;
+    if (m_cache) texture = atlas ? m_cache->atlasTexture() : m_screen ? m_cache->lastTexture(m_screen) : nullptr;
+    if (!texture) {
+        delete oldNode;
+        return nullptr;
+    }
+
+    textureProvider();
+    m_provider->setTexture(texture, !atlas && m_acquiredMipmaps);
+
+    QSGImageNode *node = static_cast<QSGImageNode *>(oldNode);
+    if (!node) {
+        node = window()->createImageNode();
+        node->setFiltering(QSGTexture::Linear);
+        node->setTextureCoordinatesTransform(QSGImageNode::MirrorVertically);
+    }
+    node->setTexture(m_provider->texture());
+    node->setRect(boundingRect());
+    node->markDirty(QSGNode::DirtyMaterial);
+    return node;
+}
+
+void BreezyDesktopOutputTextureItem::releaseResources()
+{
+    destroyProvider();
+}
+
+void BreezyDesktopOutputTextureItem::destroyProvider()
+{
+    if (!m_provider) return;
+
+    if (window()) {
+        window()->scheduleRenderJob(new ProviderCleanupJob(m_provider), QQuickWindow::AfterSynchronizingStage);
+    } else {
+        delete m_provider;
+    }
+    m_provider = nullptr;
+}
+
+} // namespace KWin
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "breezydesktopeffect.h"
+
+#include <QPointer>
+#include <QQuickItem>
+#include <QVariantList>
+
+namespace KWin
+{
+    class BreezyDesktopOutputTextureProvider;
+    class BreezyDesktopScreenTextureCache;
+
+    // Shows a screen's composited contents straight from BreezyDesktopScreenTextureCache: one texture per screen,
+    // only re-rendered on damage, instead of a WindowThumbnail per window (see DesktopView.qml).
+    // The texture is bottom-up, like everything KWin renders.
+    class BreezyDesktopOutputTextureItem : public QQuickItem
+    {
+        Q_OBJECT
+        Q_PROPERTY(QObject *screen READ screen WRITE setScreen NOTIFY screenChanged)
+        Q_PROPERTY(QObject *textureCache READ textureCache WRITE setTextureCache NOTIFY textureCacheChanged)
+        Q_PROPERTY(qreal textureScale READ textureScale WRITE setTextureScale NOTIFY textureScaleChanged)
+        Q_PROPERTY(bool mipmaps READ mipmaps WRITE setMipmaps NOTIFY mipmapsChanged)
+        Q_PROPERTY(QVariantList atlasScreens READ atlasScreens WRITE setAtlasScreens NOTIFY atlasScreensChanged)
+        Q_PROPERTY(QVariantList atlasRects READ atlasRects NOTIFY atlasRectsChanged)
+
+    public:
+        explicit BreezyDesktopOutputTextureItem(QQuickItem *parent = nullptr);
+        ~BreezyDesktopOutputTextureItem() override;
+
+        QObject *screen() const;
+        void setScreen(QObject *screen);
+
+        QObject *textureCache() const;
+        void setTextureCache(QObject *textureCache);
+
+        // relative to the screen's own scale, for displays that aren't looked at closely
+        qreal textureScale() const;
+        void setTextureScale(qreal scale);
+
+        bool mipmaps() const;
+        void setMipmaps(bool mipmaps);
+
+        // Atlas mode: when set, the item shows the cache's atlas of these screens instead of a single screen, and
+        // atlasRects holds each screen's slot in the same order (bottom-up texture coordinates). The cache has a
+        // single atlas, so only one item should use this at a time.
+        QVariantList atlasScreens() const;
+        void setAtlasScreens(const QVariantList &screens);
+        QVariantList atlasRects() const;
+
+        bool isTextureProvider() const override;
+        QSGTextureProvider *textureProvider() const override;
+
+    Q_SIGNALS:
+        void screenChanged();
+        void textureCacheChanged();
+        void textureScaleChanged();
+        void mipmapsChanged();
+        void atlasScreensChanged();
+        void atlasRectsChanged();
+
+    protected:
+        QSGNode *updatePaintNode(QSGNode *oldNode, QQuickItem::UpdatePaintNodeData *) override;
+        void itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &value) override;
+        void releaseResources() override;
+
+    private:
+        void updateAcquired();
+        void updateAtlasRects();
+        void destroyProvider();
+
+        QPointer<ScreenOutput> m_screen;
+        QPointer<BreezyDesktopScreenTextureCache> m_cache;
+        qreal m_textureScale = 1.0;
+        bool m_mipmaps = false;
+        QList<QPointer<ScreenOutput>> m_atlasScreens;
+        QVariantList m_atlasRects;
+
+        // what's currently acquired from the cache, so it can be released even after the properties changed
+        QPointer<BreezyDesktopScreenTextureCache> m_acquiredCache;
+        QPointer<ScreenOutput> m_acquiredScreen;
+        qreal m_acquiredTextureScale = 1.0;
+        bool m_acquiredMipmaps = false;
+        QList<ScreenOutput *> m_acquiredAtlasScreens;
+
+        mutable BreezyDesktopOutputTextureProvider *m_provider = nullptr;
+    };
+
+} // namespace KWin
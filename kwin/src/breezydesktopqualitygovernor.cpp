@@ -0,0 +1,95 @@
+#include "breezydesktopqualitygovernor.h"
+
+#include <array>
+
+namespace
+{
+    using Level = KWin::BreezyDesktopQualityGovernor::Level;
+
+    // cheapest first; the SSAA factors are what QtQuick3D uses for Medium, High and VeryHigh
+    constexpr std::array<Level, 6> LEVELS{{
+        {0, 0.5},
+        {0, 0.75},
+        {0, 1.0},
+        {1, 1.0},
+        {2, 1.0},
+        {3, 1.0},
+    }};
+    constexpr std::array<double, 4> SSAA_FACTORS{1.0, 1.2, 1.5, 2.0};
+
+    // evaluation windows, in frames: roughly 0.5s to step down, 3s to step up at 60Hz
+    constexpr int STEP_DOWN_WINDOW = 30;
+    constexpr int STEP_UP_WINDOW = 180;
+    constexpr int BLOCKED_LEVEL_WINDOW = 900;
+
+    constexpr double STEP_DOWN_BUDGET_RATIO = 0.9;
+    constexpr double STEP_DOWN_MISSED_RATIO = 0.1;
+    constexpr double STEP_UP_BUDGET_RATIO = 0.6;
+}
+
+namespace KWin
+{
+
+void BreezyDesktopQualityGovernor::reset()
+{
+    changeLevel(LEVELS.size() - 1);
+    m_blockedLevel = -1;
+    m_blockedFrames = 0;
+}
+
+BreezyDesktopQualityGovernor::Level BreezyDesktopQualityGovernor::level() const
+{
+    return LEVELS.at(m_level < 0 ? LEVELS.size() - 1 : m_level);
+}
+
+double BreezyDesktopQualityGovernor::relativeCost(int level)
+{
+    // pixel count relative to the native resolution without antialiasing
+    const Level &l = LEVELS.at(level);
+    const double linearScale = l.renderScale * SSAA_FACTORS.at(l.antialiasingQuality);
+    return linearScale * linearScale;
+}
+
+void BreezyDesktopQualityGovernor::changeLevel(int level)
+{
+    m_level = level;
+    m_frames = 0;
+    m_missedFrames = 0;
+    m_costSum = 0.0;
+}
+
+bool BreezyDesktopQualityGovernor::addFrame(double costMs, double budgetMs, bool missedVsync)
+{
+    if (m_level < 0) reset();
+    if (budgetMs <= 0.0) return false;
+
+    ++m_frames;
+    if (missedVsync) ++m_missedFrames;
+    m_costSum += costMs;
+    if (m_blockedLevel != -1 && ++m_blockedFrames >= BLOCKED_LEVEL_WINDOW) m_blockedLevel = -1;
+
+    const double averageCost = m_costSum / m_frames;
+    if (m_frames >= STEP_DOWN_WINDOW && m_level > 0 &&
+        (averageCost > budgetMs * STEP_DOWN_BUDGET_RATIO || m_missedFrames > m_frames * STEP_DOWN_MISSED_RATIO)) {
+        m_blockedLevel = m_level;
+        m_blockedFrames = 0;
+        changeLevel(m_level - 1);
+        return true;
+    }
+
+    if (m_frames >= STEP_UP_WINDOW) {
+        const int next = m_level + 1;
+        const bool fits = next < static_cast<int>(LEVELS.size()) && next != m_blockedLevel && m_missedFrames == 0 &&
+            averageCost * relativeCost(next) / relativeCost(m_level) < budgetMs * STEP_UP_BUDGET_RATIO;
+        if (fits) {
+            changeLevel(next);
+            return true;
+        }
+
+        // start a fresh window so old frames don't hold the estimate back
+        changeLevel(m_level);
+    }
+    return false;
+}
+
+} // namespace KWin
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QtGlobal>
+
+namespace KWin
+{
+    // Picks an antialiasing quality and render scale for the "Auto" antialiasing setting. Frames are fed in as they're
+    // painted; the level drops quickly when frames go over budget or miss vsync, and only climbs back slowly when the
+    // next level's estimated cost fits comfortably, so it doesn't oscillate around the edge of the budget.
+    class BreezyDesktopQualityGovernor
+    {
+    public:
+        struct Level {
+            int antialiasingQuality; // same values as the AntialiasingQuality setting, 0=None .. 3=VeryHigh
+            qreal renderScale;
+        };
+
+        // starts at the highest level
+        void reset();
+
+        // returns true if the level changed
+        bool addFrame(double costMs, double budgetMs, bool missedVsync);
+
+        Level level() const;
+
+    private:
+        void changeLevel(int level);
+        static double relativeCost(int level);
+
+        int m_level = -1;
+        int m_frames = 0;
+        int m_missedFrames = 0;
+        double m_costSum = 0.0;
+
+        // stepping back up to a level that just proved too expensive waits for a longer stretch of good frames
+        int m_blockedLevel = -1;
+        int m_blockedFrames = 0;
+    };
+
+} // namespace KWin
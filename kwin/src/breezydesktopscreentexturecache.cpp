@@ -0,0 +1,431 @@
+#include "breezydesktopscreentexturecache.h"
+
+#include "core/output.h"
+#include "core/rendertarget.h"
+#include "core/renderviewport.h"
+#include "effect/effecthandler.h"
+#include "effect/effectwindow.h"
+#include "opengl/glutils.h"
+
+#include <QLoggingCategory>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+Q_DECLARE_LOGGING_CATEGORY(KWIN_XR)
+
+namespace KWin
+{
+
+BreezyDesktopScreenTextureCache::BreezyDesktopScreenTextureCache(QObject *parent)
+    : QObject(parent)
+{
+    connect(effects, &EffectsHandler::windowAdded, this, [this](EffectWindow *window) {
+        trackWindow(window);
+        markDirty(window->expandedGeometry());
+    });
+    connect(effects, &EffectsHandler::windowClosed, this, [this](EffectWindow *window) {
+        markDirty(window->expandedGeometry());
+    });
+    connect(effects, &EffectsHandler::windowDamaged, this, [this](EffectWindow *window) {
+        markDirty(window->expandedGeometry());
+    });
+    connect(effects, &EffectsHandler::stackingOrderChanged, this, &BreezyDesktopScreenTextureCache::markAllDirty);
+    connect(effects, &EffectsHandler::desktopChanged, this, &BreezyDesktopScreenTextureCache::markAllDirty);
+    connect(effects, &EffectsHandler::currentActivityChanged, this, &BreezyDesktopScreenTextureCache::markAllDirty);
+    connect(effects, &EffectsHandler::screenRemoved, this, [this](ScreenOutput *screen) {
+        m_damagedScreens.remove(screen);
+        m_entries.erase(screen);
+        if (m_atlasScreens.removeAll(screen) > 0) m_atlasSlots.remove(screen);
+    });
+
+    const auto windows = effects->stackingOrder();
+    for (EffectWindow *window : windows) {
+        trackWindow(window);
+    }
+
+    m_rateLimitTimer.setSingleShot(true);
+    connect(&m_rateLimitTimer, &QTimer::timeout, this, &BreezyDesktopScreenTextureCache::acquiredScreenDamaged);
+}
+
+BreezyDesktopScreenTextureCache::~BreezyDesktopScreenTextureCache()
+{
+    for (auto &[screen, entry] : m_entries) {
+        if (entry.fence) glDeleteSync(entry.fence);
+    }
+    if (m_atlasFence) glDeleteSync(m_atlasFence);
+}
+
+void BreezyDesktopScreenTextureCache::trackWindow(EffectWindow *window)
+{
+    connect(window, &EffectWindow::windowFrameGeometryChanged, this, [this](EffectWindow *window, const QRectF &oldGeometry) {
+        markDirty(oldGeometry);
+        markDirty(window->expandedGeometry());
+    });
+    connect(window, &EffectWindow::minimizedChanged, this, [this](EffectWindow *window) {
+        markDirty(window->expandedGeometry());
+    });
+}
+
+void BreezyDesktopScreenTextureCache::markDirty(const QRectF &area)
+{
+    const bool hadDamage = !m_damagedScreens.isEmpty();
+    const auto screens = effects->screens();
+    for (ScreenOutput *screen : screens) {
+        if (screen->geometry().intersects(area.toAlignedRect())) m_damagedScreens.insert(screen);
+    }
+    if (!hadDamage && !m_damagedScreens.isEmpty()) Q_EMIT screensDamaged();
+
+    bool acquiredDamaged = false;
+    for (auto &[screen, entry] : m_entries) {
+        if (!entry.geometry.intersects(area)) continue;
+        acquiredDamaged |= entry.acquired > 0 && !entry.dirty;
+        entry.dirty = true;
+    }
+    if (acquiredDamaged) Q_EMIT acquiredScreenDamaged();
+}
+
+void BreezyDesktopScreenTextureCache::markAllDirty()
+{
+    const bool hadDamage = !m_damagedScreens.isEmpty();
+    const auto screens = effects->screens();
+    for (ScreenOutput *screen : screens) {
+        m_damagedScreens.insert(screen);
+    }
+    if (!hadDamage && !m_damagedScreens.isEmpty()) Q_EMIT screensDamaged();
+
+    bool acquiredDamaged = false;
+    for (auto &[screen, entry] : m_entries) {
+        acquiredDamaged |= entry.acquired > 0 && !entry.dirty;
+        entry.dirty = true;
+    }
+    if (acquiredDamaged) Q_EMIT acquiredScreenDamaged();
+}
+
+GLTexture *BreezyDesktopScreenTextureCache::texture(ScreenOutput *screen, qreal scale)
+{
+    if (!screen) return nullptr;
+
+    Entry &entry = m_entries[screen];
+    if (!updateEntry(screen, entry, scale)) {
+        m_entries.erase(screen);
+        return nullptr;
+    }
+    return entry.texture.get();
+}
+
+bool BreezyDesktopScreenTextureCache::updateEntry(ScreenOutput *screen, Entry &entry, qreal scale)
+{
+    const QRectF geometry = screen->geometry();
+    const QSize size = (geometry.size() * scale).toSize();
+    if (size.isEmpty()) return false;
+
+    if (!entry.texture || entry.texture->size() != size) {
+        entry.framebuffer.reset();
+        entry.texture = GLTexture::allocate(GL_RGBA8, size);
+        if (!entry.texture) {
+            qCWarning(KWIN_XR) << "\t\t\tBreezy - screen texture allocation failed for" << screen->name() << size;
+            return false;
+        }
+        entry.texture->setFilter(GL_LINEAR);
+        entry.texture->setWrapMode(GL_CLAMP_TO_EDGE);
+        entry.framebuffer = std::make_unique<GLFramebuffer>(entry.texture.get());
+        entry.dirty = true;
+    }
+
+    if (entry.geometry != geometry || entry.scale != scale) {
+        entry.geometry = geometry;
+        entry.scale = scale;
+        entry.dirty = true;
+    }
+
+    if (entry.dirty) {
+        const auto renderStart = std::chrono::steady_clock::now();
+        renderScreen(screen, entry.framebuffer.get(), scale);
+        if (entry.mipmaps) entry.texture->generateMipmaps();
+        entry.texture->setFilter(entry.mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        m_renderTime.add(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - renderStart).count());
+        entry.dirty = false;
+    }
+    return true;
+}
+
+void BreezyDesktopScreenTextureCache::acquire(ScreenOutput *screen, qreal textureScale, bool mipmaps)
+{
+    if (!screen) return;
+
+    Entry &entry = m_entries[screen];
+    const bool optionsChanged = entry.textureScale != textureScale || entry.mipmaps != mipmaps;
+    entry.textureScale = textureScale;
+    entry.mipmaps = mipmaps;
+    if (entry.acquired++ == 0 || optionsChanged) {
+        entry.dirty = true;
+        Q_EMIT acquiredScreenDamaged();
+    }
+}
+
+void BreezyDesktopScreenTextureCache::release(ScreenOutput *screen)
+{
+    // the texture stays around so the consumer can keep showing its last contents, e.g. while culled
+    auto it = m_entries.find(screen);
+    if (it != m_entries.end() && it->second.acquired > 0) --it->second.acquired;
+}
+
+void BreezyDesktopScreenTextureCache::setUpdateRateLimit(ScreenOutput *screen, int textureUpdateRate)
+{
+    if (!screen) return;
+    m_entries[screen].minUpdateInterval = textureUpdateRate > 0 ?
+        std::chrono::nanoseconds(1'000'000'000 / textureUpdateRate) :
+        std::chrono::nanoseconds::zero();
+}
+
+int BreezyDesktopScreenTextureCache::updateAcquired()
+{
+    int updated = 0;
+    QSet<ScreenOutput *> updatedScreens;
+    const auto now = std::chrono::steady_clock::now();
+    std::chrono::nanoseconds nextUpdate = std::chrono::nanoseconds::max();
+    for (auto &[screen, entry] : m_entries) {
+        const qreal scale = screen->scale() * entry.textureScale;
+        if (entry.acquired == 0 || (!entry.dirty && entry.texture && entry.geometry == screen->geometry() && entry.scale == scale)) continue;
+        if (entry.texture && now - entry.lastUpdate < entry.minUpdateInterval) {
+            nextUpdate = std::min(nextUpdate, std::chrono::duration_cast<std::chrono::nanoseconds>(entry.minUpdateInterval - (now - entry.lastUpdate)));
+            ++m_rateLimitedUpdates;
+            continue;
+        }
+        if (!updateEntry(screen, entry, scale)) continue;
+        entry.lastUpdate = now;
+
+        // the texture is sampled from QtQuick's context, which only waits for this fence
+        if (entry.fence) glDeleteSync(entry.fence);
+        entry.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        ++updated;
+        updatedScreens.insert(screen);
+        Q_EMIT textureUpdated(screen);
+    }
+
+    if (!m_atlasScreens.isEmpty()) updateAtlas(updatedScreens);
+
+    if (nextUpdate != std::chrono::nanoseconds::max() && !m_rateLimitTimer.isActive()) {
+        m_rateLimitTimer.start(std::chrono::ceil<std::chrono::milliseconds>(nextUpdate));
+    }
+    return updated;
+}
+
+void BreezyDesktopScreenTextureCache::setAtlasScreens(const QList<ScreenOutput *> &screens)
+{
+    if (m_atlasScreens == screens) return;
+
+    // acquire before releasing so screens staying in the atlas aren't re-rendered
+    for (ScreenOutput *screen : screens) {
+        acquire(screen);
+    }
+    for (ScreenOutput *screen : std::as_const(m_atlasScreens)) {
+        release(screen);
+    }
+    m_atlasScreens = screens;
+    if (m_atlasScreens.isEmpty()) resetAtlas();
+    Q_EMIT acquiredScreenDamaged();
+}
+
+QRectF BreezyDesktopScreenTextureCache::atlasRect(ScreenOutput *screen) const
+{
+    auto it = m_atlasSlots.constFind(screen);
+    if (it == m_atlasSlots.constEnd() || !m_atlasTexture) return QRectF();
+
+    const QSizeF size = m_atlasTexture->size();
+    const QRect &slot = it.value();
+    return QRectF(slot.x() / size.width(), (size.height() - slot.y() - slot.height()) / size.height(),
+                  slot.width() / size.width(), slot.height() / size.height());
+}
+
+GLTexture *BreezyDesktopScreenTextureCache::atlasTexture()
+{
+    if (m_atlasFence) {
+        glWaitSync(m_atlasFence, 0, GL_TIMEOUT_IGNORED);
+        glDeleteSync(m_atlasFence);
+        m_atlasFence = nullptr;
+    }
+    return m_atlasTexture.get();
+}
+
+void BreezyDesktopScreenTextureCache::resetAtlas()
+{
+    const bool hadLayout = !m_atlasSlots.isEmpty();
+    m_atlasSlots.clear();
+    m_atlasFramebuffer.reset();
+    m_atlasTexture.reset();
+    if (m_atlasFence) {
+        glDeleteSync(m_atlasFence);
+        m_atlasFence = nullptr;
+    }
+    if (hadLayout) Q_EMIT atlasLayoutChanged();
+}
+
+void BreezyDesktopScreenTextureCache::updateAtlas(const QSet<ScreenOutput *> &updatedScreens)
+{
+    if (!GLFramebuffer::supportsBlits()) return;
+    if (m_maxTextureSize == 0) glGetIntegerv(GL_MAX_TEXTURE_SIZE, &m_maxTextureSize);
+
+    // shelf packing in screen order, aiming for a roughly square atlas; slots are padded so linear filtering at a
+    // display's edge doesn't pick up its neighbour
+    constexpr int padding = 2;
+    QList<QSize> sizes;
+    int widest = 0;
+    qint64 area = 0;
+    for (ScreenOutput *screen : std::as_const(m_atlasScreens)) {
+        auto it = m_entries.find(screen);
+        if (it == m_entries.end() || !it->second.texture) return; // not rendered yet, lay out once all are
+
+        const QSize size = it->second.texture->size();
+        sizes.append(size);
+        widest = std::max(widest, size.width());
+        area += qint64(size.width() + padding) * (size.height() + padding);
+    }
+
+    const int rowWidth = std::max(widest, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(area)))));
+    QHash<ScreenOutput *, QRect> slots;
+    QPoint cursor;
+    QSize atlasSize;
+    int rowHeight = 0;
+    for (int i = 0; i < m_atlasScreens.size(); ++i) {
+        const QSize &size = sizes.at(i);
+        if (cursor.x() > 0 && cursor.x() + size.width() > rowWidth) {
+            cursor = QPoint(0, cursor.y() + rowHeight + padding);
+            rowHeight = 0;
+        }
+        slots.insert(m_atlasScreens.at(i), QRect(cursor, size));
+        cursor.rx() += size.width() + padding;
+        rowHeight = std::max(rowHeight, size.height());
+        atlasSize = atlasSize.expandedTo(QSize(cursor.x() - padding, cursor.y() + rowHeight));
+    }
+
+    if (atlasSize.width() > m_maxTextureSize || atlasSize.height() > m_maxTextureSize) {
+        if (m_atlasTexture || !m_atlasSlots.isEmpty()) {
+            qCWarning(KWIN_XR) << "\t\t\tBreezy - screen texture atlas" << atlasSize << "exceeds the maximum texture size" << m_maxTextureSize;
+        }
+        resetAtlas();
+        return;
+    }
+
+    QSet<ScreenOutput *> stale = updatedScreens;
+    if (slots != m_atlasSlots || !m_atlasTexture || m_atlasTexture->size() != atlasSize) {
+        if (!m_atlasTexture || m_atlasTexture->size() != atlasSize) {
+            m_atlasFramebuffer.reset();
+            m_atlasTexture = GLTexture::allocate(GL_RGBA8, atlasSize);
+            if (!m_atlasTexture) {
+                qCWarning(KWIN_XR) << "\t\t\tBreezy - screen texture atlas allocation failed" << atlasSize;
+                resetAtlas();
+                return;
+            }
+            m_atlasTexture->setFilter(GL_LINEAR);
+            m_atlasTexture->setWrapMode(GL_CLAMP_TO_EDGE);
+            m_atlasFramebuffer = std::make_unique<GLFramebuffer>(m_atlasTexture.get());
+        }
+
+        GLFramebuffer::pushFramebuffer(m_atlasFramebuffer.get());
+        glClearColor(0.0, 0.0, 0.0, 1.0);
+        glClear(GL_COLOR_BUFFER_BIT);
+        GLFramebuffer::popFramebuffer();
+
+        m_atlasSlots = slots;
+        stale = QSet<ScreenOutput *>(m_atlasScreens.begin(), m_atlasScreens.end());
+        Q_EMIT atlasLayoutChanged();
+    }
+
+    int copied = 0;
+    for (ScreenOutput *screen : std::as_const(stale)) {
+        auto slot = m_atlasSlots.constFind(screen);
+        auto it = m_entries.find(screen);
+        if (slot == m_atlasSlots.constEnd() || it == m_entries.end() || !it->second.framebuffer) continue;
+
+        GLFramebuffer::pushFramebuffer(it->second.framebuffer.get());
+        m_atlasFramebuffer->blitFromFramebuffer(QRect(QPoint(0, 0), slot->size()), *slot, GL_NEAREST);
+        GLFramebuffer::popFramebuffer();
+        ++copied;
+    }
+    if (copied == 0) return;
+
+    if (m_atlasFence) glDeleteSync(m_atlasFence);
+    m_atlasFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    Q_EMIT atlasUpdated();
+}
+
+int BreezyDesktopScreenTextureCache::acquiredCount() const
+{
+    return std::count_if(m_entries.begin(), m_entries.end(), [](const auto &item) {
+        return item.second.acquired > 0;
+    });
+}
+
+QSet<ScreenOutput *> BreezyDesktopScreenTextureCache::takeDamagedScreens()
+{
+    return std::exchange(m_damagedScreens, {});
+}
+
+GLTexture *BreezyDesktopScreenTextureCache::lastTexture(ScreenOutput *screen)
+{
+    auto it = m_entries.find(screen);
+    if (it == m_entries.end()) return nullptr;
+
+    Entry &entry = it->second;
+    if (entry.fence) {
+        glWaitSync(entry.fence, 0, GL_TIMEOUT_IGNORED);
+        glDeleteSync(entry.fence);
+        entry.fence = nullptr;
+    }
+    return entry.texture.get();
+}
+
+qint64 BreezyDesktopScreenTextureCache::textureMemoryBytes() const
+{
+    qint64 bytes = 0;
+    for (const auto &[screen, entry] : m_entries) {
+        if (!entry.texture) continue;
+        const qint64 levelBytes = qint64(entry.texture->width()) * entry.texture->height() * 4;
+
+        // a full mip chain adds a third
+        bytes += entry.mipmaps ? levelBytes * 4 / 3 : levelBytes;
+    }
+    if (m_atlasTexture) bytes += qint64(m_atlasTexture->width()) * m_atlasTexture->height() * 4;
+    return bytes;
+}
+
+quint64 &BreezyDesktopScreenTextureCache::rateLimitedUpdates()
+{
+    return m_rateLimitedUpdates;
+}
+
+BreezyStats::RunningStat &BreezyDesktopScreenTextureCache::renderTime()
+{
+    return m_renderTime;
+}
+
+void BreezyDesktopScreenTextureCache::renderScreen(ScreenOutput *screen, GLFramebuffer *framebuffer, qreal scale)
+{
+    const QRect geometry = screen->geometry();
+
+    GLFramebuffer::pushFramebuffer(framebuffer);
+    glClearColor(0.0, 0.0, 0.0, 1.0);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    RenderTarget renderTarget(framebuffer);
+    RenderViewport viewport(geometry, scale, renderTarget);
+
+    // same filtering as DesktopView.qml: on this screen, desktop and activity, and not minimized
+    const auto windows = effects->stackingOrder();
+    for (EffectWindow *window : windows) {
+        if (window->isDeleted() || window->isMinimized()) continue;
+        if (!window->isOnCurrentDesktop() || !window->isOnCurrentActivity()) continue;
+        if (!window->expandedGeometry().intersects(geometry)) continue;
+
+        WindowPaintData data;
+        effects->drawWindow(renderTarget, viewport, window, Effect::PAINT_WINDOW_TRANSFORMED, PaintRegion(geometry), data);
+    }
+
+    GLFramebuffer::popFramebuffer();
+}
+
+} // namespace KWin
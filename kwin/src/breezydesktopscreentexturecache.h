@@ -0,0 +1,118 @@
+#pragma once
+
+#include "breezydesktopeffect.h"
+#include "breezydesktopstats.h"
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QRectF>
+#include <QSet>
+#include <QTimer>
+
+#include <epoxy/gl.h>
+
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+
+namespace KWin
+{
+    class EffectWindow;
+    class GLFramebuffer;
+    class GLTexture;
+
+    // Per-screen offscreen textures holding that screen's windows, for render paths that don't go through
+    // QtQuick's WindowThumbnail. A screen's texture is only re-rendered after something on it was damaged.
+    class BreezyDesktopScreenTextureCache : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit BreezyDesktopScreenTextureCache(QObject *parent = nullptr);
+        ~BreezyDesktopScreenTextureCache() override;
+
+        // returns nullptr if the texture can't be allocated, must be called with the OpenGL context current
+        GLTexture *texture(ScreenOutput *screen, qreal scale);
+
+        void markDirty(const QRectF &area);
+        void markAllDirty();
+
+        // Acquired screens are kept up to date by updateAcquired() for consumers that sample them outside of the
+        // compositor's paint pass (BreezyDesktopOutputTextureItem), rendered at the screen's own scale times
+        // textureScale. Acquiring again with different options re-renders the texture.
+        void acquire(ScreenOutput *screen, qreal textureScale = 1.0, bool mipmaps = false);
+        void release(ScreenOutput *screen);
+
+        // Caps how often updateAcquired() re-renders the screen, 0 for no limit. Damage that arrives in between is
+        // rendered once the interval is over, acquiredScreenDamaged() is emitted again then.
+        void setUpdateRateLimit(ScreenOutput *screen, int textureUpdateRate);
+
+        // re-renders damaged acquired screens and returns how many were, must be called with the OpenGL context current
+        int updateAcquired();
+        int acquiredCount() const;
+
+        // screens whose contents changed since the last call, for every screen and not only cached ones
+        QSet<ScreenOutput *> takeDamagedScreens();
+
+        // the last texture rendered for the screen, or nullptr; waits on the caller's context for the rendering to land
+        GLTexture *lastTexture(ScreenOutput *screen);
+
+        // The atlas packs the given screens' textures into a single texture, so all displays can be drawn with one
+        // instanced draw call. The screens are acquired at their own scale without mipmaps and copied in by
+        // updateAcquired() whenever they're re-rendered. An empty list turns the atlas off.
+        void setAtlasScreens(const QList<ScreenOutput *> &screens);
+
+        // the screen's slot in bottom-up texture coordinates, or a null rect if it isn't in the atlas (yet)
+        QRectF atlasRect(ScreenOutput *screen) const;
+
+        // the atlas texture, or nullptr if it couldn't be laid out; waits like lastTexture()
+        GLTexture *atlasTexture();
+
+        BreezyStats::RunningStat &renderTime();
+        quint64 &rateLimitedUpdates(); // damaged screens held back by setUpdateRateLimit()
+        qint64 textureMemoryBytes() const;
+
+    Q_SIGNALS:
+        // the damaged screens set became non-empty
+        void screensDamaged();
+        void acquiredScreenDamaged();
+        void textureUpdated(ScreenOutput *screen);
+        void atlasUpdated();
+        void atlasLayoutChanged();
+
+    private:
+        void trackWindow(EffectWindow *window);
+        void renderScreen(ScreenOutput *screen, GLFramebuffer *framebuffer, qreal scale);
+
+        struct Entry {
+            std::unique_ptr<GLTexture> texture;
+            std::unique_ptr<GLFramebuffer> framebuffer;
+            QRectF geometry;
+            qreal scale = 1.0;
+            bool dirty = true;
+            int acquired = 0;
+            qreal textureScale = 1.0;
+            bool mipmaps = false;
+            GLsync fence = nullptr;
+            std::chrono::nanoseconds minUpdateInterval{0};
+            std::chrono::steady_clock::time_point lastUpdate;
+        };
+        bool updateEntry(ScreenOutput *screen, Entry &entry, qreal scale);
+        std::unordered_map<ScreenOutput *, Entry> m_entries;
+
+        void updateAtlas(const QSet<ScreenOutput *> &updatedScreens);
+        void resetAtlas();
+        QList<ScreenOutput *> m_atlasScreens;
+        QHash<ScreenOutput *, QRect> m_atlasSlots; // pixels, top-left origin like GLFramebuffer::blitFromFramebuffer
+        std::unique_ptr<GLTexture> m_atlasTexture;
+        std::unique_ptr<GLFramebuffer> m_atlasFramebuffer;
+        GLsync m_atlasFence = nullptr;
+        GLint m_maxTextureSize = 0;
+        QSet<ScreenOutput *> m_damagedScreens;
+        BreezyStats::RunningStat m_renderTime; // ms per screen render
+        QTimer m_rateLimitTimer;
+        quint64 m_rateLimitedUpdates = 0;
+    };
+
+} // namespace KWin
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+
+namespace KWin
+{
+namespace BreezyStats
+{
+    // Running min/avg/max accumulator (milliseconds, degrees, ...). Owned and reset by whoever reports it.
+    struct RunningStat {
+        quint64 count = 0;
+        double sum = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+
+        void add(double value)
+        {
+            min = count == 0 ? value : std::min(min, value);
+            max = count == 0 ? value : std::max(max, value);
+            sum += value;
+            ++count;
+        }
+
+        double average() const
+        {
+            return count == 0 ? 0.0 : sum / count;
+        }
+
+        void reset()
+        {
+            *this = RunningStat();
+        }
+    };
+
+    // Event counter that any thread can bump without locking.
+    struct AtomicCounter {
+        std::atomic<quint64> value{0};
+
+        void add(quint64 n = 1)
+        {
+            value.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        quint64 load() const
+        {
+            return value.load(std::memory_order_relaxed);
+        }
+    };
+
+    // Lock-free histogram for percentiles of values recorded from any thread. Bucket bounds grow by 2^(1/4) from
+    // firstBound, so a percentile is the upper bound of its bucket and at most ~19% high, up to about 55000 times
+    // firstBound: 2.7 seconds for milliseconds with the default. Larger values all land in the last bucket. Reading
+    // while values are recorded just gives a slightly older snapshot.
+    class AtomicHistogram
+    {
+    public:
+        static constexpr int BUCKETS = 64;
+
+        explicit AtomicHistogram(double firstBound = 0.05)
+            : m_firstBound(firstBound)
+        {
+        }
+
+        void add(double value)
+        {
+            m_buckets[bucketFor(value)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // p in [0, 1], 0 if nothing was recorded
+        double percentile(double p) const
+        {
+            std::array<quint64, BUCKETS> counts;
+            quint64 total = 0;
+            for (int i = 0; i < BUCKETS; ++i) {
+                counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+                total += counts[i];
+            }
+            if (total == 0) return 0.0;
+
+            const quint64 rank = std::max<quint64>(1, std::ceil(p * total));
+            quint64 seen = 0;
+            for (int i = 0; i < BUCKETS; ++i) {
+                seen += counts[i];
+                if (seen >= rank) return upperBound(i);
+            }
+            return upperBound(BUCKETS - 1);
+        }
+
+        quint64 count() const
+        {
+            quint64 total = 0;
+            for (const auto &bucket : m_buckets) {
+                total += bucket.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
+    private:
+        static constexpr double BUCKETS_PER_DOUBLING = 4.0;
+
+        double upperBound(int bucket) const
+        {
+            return m_firstBound * std::exp2(bucket / BUCKETS_PER_DOUBLING);
+        }
+
+        int bucketFor(double value) const
+        {
+            if (!(value > m_firstBound)) return 0;
+            const int bucket = static_cast<int>(std::ceil(std::log2(value / m_firstBound) * BUCKETS_PER_DOUBLING));
+            return std::min(bucket, BUCKETS - 1);
+        }
+
+        const double m_firstBound;
+        std::array<std::atomic<quint64>, BUCKETS> m_buckets{};
+    };
+} // namespace BreezyStats
+} // namespace KWin
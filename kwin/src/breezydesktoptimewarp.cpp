@@ -0,0 +1,152 @@
+#include "breezydesktoptimewarp.h"
+#include "breezydesktopglsl.h"
+
+#include "core/output.h"
+#include "core/renderviewport.h"
+#include "opengl/glutils.h"
+
+#include <QLoggingCategory>
+#include <QMatrix4x4>
+#include <QVector4D>
+
+Q_DECLARE_LOGGING_CATEGORY(KWIN_XR)
+
+namespace
+{
+    // Casts the view ray of each output pixel from the newest camera orientation, rotates it into the
+    // camera the scene was rendered with, and samples the scene where that ray lands. Versioned in ensureShader().
+    const QByteArray TIMEWARP_FRAGMENT_SHADER = QByteArrayLiteral(R"(
+uniform sampler2D sampler;
+uniform mat4 deltaRotation;
+uniform vec2 fovHalfTangents;
+uniform vec4 headLockedRect; // left, bottom, right, top in texcoords, empty for none
+
+in vec2 texcoord0;
+out vec4 fragColor;
+
+void main()
+{
+    if (all(greaterThanEqual(texcoord0, headLockedRect.xy)) && all(lessThan(texcoord0, headLockedRect.zw))) {
+        fragColor = texture(sampler, texcoord0);
+        return;
+    }
+
+    vec2 ndc = texcoord0 * 2.0 - 1.0;
+    vec3 ray = (deltaRotation * vec4(ndc * fovHalfTangents, -1.0, 0.0)).xyz;
+    if (ray.z >= 0.0) {
+        fragColor = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+
+    vec2 uv = (ray.xy / -ray.z) / fovHalfTangents * 0.5 + 0.5;
+    if (any(lessThan(uv, vec2(0.0))) || any(greaterThan(uv, vec2(1.0)))) {
+        fragColor = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+
+    fragColor = texture(sampler, uv);
+}
+)");
+}
+
+namespace KWin
+{
+
+BreezyDesktopTimewarp::BreezyDesktopTimewarp() = default;
+
+BreezyDesktopTimewarp::~BreezyDesktopTimewarp() = default;
+
+GLFramebuffer *BreezyDesktopTimewarp::sceneFramebuffer(const QSize &size)
+{
+    if (size.isEmpty()) return nullptr;
+
+    if (!m_texture || m_texture->size() != size) {
+        m_framebuffer.reset();
+        m_hasFrame = false;
+        m_texture = GLTexture::allocate(GL_RGBA8, size);
+        if (!m_texture) {
+            qCWarning(KWIN_XR) << "\t\t\tBreezy - timewarp texture allocation failed for size" << size;
+            return nullptr;
+        }
+        // framebuffer contents are bottom-up, which also keeps texcoord0 in the shader y-up like NDC
+        m_texture->setContentTransform(OutputTransform::FlipY);
+        m_texture->setFilter(GL_LINEAR);
+        m_texture->setWrapMode(GL_CLAMP_TO_EDGE);
+
+        m_framebuffer = std::make_unique<GLFramebuffer>(m_texture.get());
+        if (!m_framebuffer->valid()) {
+            qCWarning(KWIN_XR) << "\t\t\tBreezy - timewarp framebuffer is incomplete";
+            m_framebuffer.reset();
+            m_texture.reset();
+            return nullptr;
+        }
+    }
+
+    return m_framebuffer.get();
+}
+
+bool BreezyDesktopTimewarp::hasFrame(const QSize &size) const
+{
+    return m_hasFrame && m_texture && m_texture->size() == size;
+}
+
+void BreezyDesktopTimewarp::setFrameRendered()
+{
+    m_hasFrame = m_texture != nullptr;
+}
+
+bool BreezyDesktopTimewarp::ensureShader()
+{
+    if (m_shader) return true;
+    if (m_shaderFailed) return false;
+
+    m_shader = ShaderManager::instance()->generateCustomShader(ShaderTrait::MapTexture, QByteArray(), BreezyGlsl::versioned(TIMEWARP_FRAGMENT_SHADER));
+    if (!m_shader || !m_shader->isValid()) {
+        qCWarning(KWIN_XR) << "\t\t\tBreezy - timewarp shader failed to compile, reprojection disabled";
+        m_shader.reset();
+        m_shaderFailed = true;
+        return false;
+    }
+    return true;
+}
+
+bool BreezyDesktopTimewarp::paint(const RenderViewport &viewport,
+                                  const QRectF &geometry,
+                                  const QQuaternion &renderedOrientation,
+                                  const QQuaternion &displayOrientation,
+                                  const QVector2D &fovHalfTangents,
+                                  const QRectF &headLockedRect)
+{
+    if (!m_hasFrame || !ensureShader()) return false;
+
+    // a ray in the newest camera's space, moved into world space and then into the rendered camera's space
+    const QQuaternion delta = renderedOrientation.conjugated() * displayOrientation;
+    QMatrix4x4 deltaRotation;
+    deltaRotation.rotate(delta);
+
+    QMatrix4x4 mvp = viewport.projectionMatrix();
+    mvp.translate(geometry.x(), geometry.y());
+
+    ShaderManager::instance()->pushShader(m_shader.get());
+    m_shader->setUniform(GLShader::Mat4Uniform::ModelViewProjectionMatrix, mvp);
+    m_shader->setUniform("deltaRotation", deltaRotation);
+    m_shader->setUniform("fovHalfTangents", fovHalfTangents);
+    // texcoords are y-up like the framebuffer, the rect is top-down like the screen
+    QVector4D lockedTexcoords;
+    if (!headLockedRect.isEmpty() && !geometry.isEmpty()) {
+        lockedTexcoords = QVector4D(headLockedRect.left() / geometry.width(),
+                                    1.0 - headLockedRect.bottom() / geometry.height(),
+                                    headLockedRect.right() / geometry.width(),
+                                    1.0 - headLockedRect.top() / geometry.height());
+    }
+    m_shader->setUniform("headLockedRect", lockedTexcoords);
+
+    m_texture->bind();
+    m_texture->render(geometry.size());
+    m_texture->unbind();
+
+    ShaderManager::instance()->popShader();
+    return true;
+}
+
+} // namespace KWin
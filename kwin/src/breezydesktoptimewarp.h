@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QQuaternion>
+#include <QRectF>
+#include <QSize>
+#include <QVector2D>
+
+#include <memory>
+
+namespace KWin
+{
+    class GLFramebuffer;
+    class GLShader;
+    class GLTexture;
+    class RenderViewport;
+
+    // Rotational reprojection of the last rendered scene frame. The scene is rendered into sceneFramebuffer(),
+    // then paint() draws it re-rotated from the orientation it was rendered with to the newest one.
+    class BreezyDesktopTimewarp
+    {
+    public:
+        BreezyDesktopTimewarp();
+        ~BreezyDesktopTimewarp();
+
+        // (re)allocates the offscreen target if the size changed, returns nullptr if it can't be created
+        GLFramebuffer *sceneFramebuffer(const QSize &size);
+
+        // whether a scene frame of this size has been rendered and can be reprojected
+        bool hasFrame(const QSize &size) const;
+        void setFrameRendered();
+
+        // fovHalfTangents are tan(fov / 2) for the horizontal and vertical camera FOVs. headLockedRect, relative to
+        // geometry, is drawn as rendered instead of reprojected, for overlays that move with the head.
+        bool paint(const RenderViewport &viewport,
+                   const QRectF &geometry,
+                   const QQuaternion &renderedOrientation,
+                   const QQuaternion &displayOrientation,
+                   const QVector2D &fovHalfTangents,
+                   const QRectF &headLockedRect = QRectF());
+
+    private:
+        bool ensureShader();
+
+        std::unique_ptr<GLShader> m_shader;
+        std::unique_ptr<GLTexture> m_texture;
+        std::unique_ptr<GLFramebuffer> m_framebuffer;
+        bool m_shaderFailed = false;
+        bool m_hasFrame = false;
+    };
+
+} // namespace KWin
@@ -0,0 +1,75 @@
+#include "breezydesktoptrace.h"
+
+#include <QLoggingCategory>
+
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+Q_DECLARE_LOGGING_CATEGORY(KWIN_XR)
+
+namespace
+{
+    // -1 if tracefs isn't mounted or writable, each write is then a single failed branch
+    int markerFd()
+    {
+        static const int fd = []() {
+            for (const char *path : {"/sys/kernel/tracing/trace_marker", "/sys/kernel/debug/tracing/trace_marker"}) {
+                const int fd = open(path, O_WRONLY | O_CLOEXEC);
+                if (fd >= 0) return fd;
+            }
+            qCWarning(KWIN_XR) << "\t\t\tBreezy - tracing enabled, but trace_marker can't be opened";
+            return -1;
+        }();
+        return fd;
+    }
+
+    // systrace's trace_marker format, which Perfetto turns into slices, async slices and counters
+    template<typename... Args>
+    void writeMarker(const char *format, Args... args)
+    {
+        const int fd = markerFd();
+        if (fd < 0) return;
+
+        char buffer[256];
+        const int length = std::snprintf(buffer, sizeof(buffer), format, args...);
+        if (length <= 0) return;
+
+        // a single write() lands atomically, no locking needed across threads
+        [[maybe_unused]] const ssize_t written = write(fd, buffer, std::min<size_t>(length, sizeof(buffer) - 1));
+    }
+}
+
+namespace KWin
+{
+namespace BreezyTrace
+{
+
+void begin(const char *name)
+{
+    writeMarker("B|%d|%s", getpid(), name);
+}
+
+void end()
+{
+    writeMarker("E|%d", getpid());
+}
+
+void asyncBegin(const char *name, quint64 cookie)
+{
+    writeMarker("S|%d|%s|%llu", getpid(), name, static_cast<unsigned long long>(cookie));
+}
+
+void asyncEnd(const char *name, quint64 cookie)
+{
+    writeMarker("F|%d|%s|%llu", getpid(), name, static_cast<unsigned long long>(cookie));
+}
+
+void counter(const char *name, qint64 value)
+{
+    writeMarker("C|%d|%s|%lld", getpid(), name, static_cast<long long>(value));
+}
+
+} // namespace BreezyTrace
+} // namespace KWin
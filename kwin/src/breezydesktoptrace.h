@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QtGlobal>
+
+// Pose-to-photon trace points, written to ftrace's trace_marker so they line up with KWin's, Mesa's and the kernel's
+// events in Perfetto or trace-cmd (record with the "ftrace/print" event enabled). Each pose sample gets an async
+// "pose" slice from when updatePose() reads it to when the first frame rendered with it is submitted, keyed by the
+// pose's timestamp. Everything compiles to nothing unless the plugin is built with BREEZY_DESKTOP_TRACING.
+#ifdef BREEZY_DESKTOP_TRACING
+
+namespace KWin
+{
+namespace BreezyTrace
+{
+    void begin(const char *name);
+    void end();
+    void asyncBegin(const char *name, quint64 cookie);
+    void asyncEnd(const char *name, quint64 cookie);
+    void counter(const char *name, qint64 value);
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char *name)
+        {
+            begin(name);
+        }
+        ~Scope()
+        {
+            end();
+        }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+    };
+} // namespace BreezyTrace
+} // namespace KWin
+
+#define BREEZY_TRACE_CONCAT_INNER(a, b) a##b
+#define BREEZY_TRACE_CONCAT(a, b) BREEZY_TRACE_CONCAT_INNER(a, b)
+#define BREEZY_TRACE_SCOPE(name) const KWin::BreezyTrace::Scope BREEZY_TRACE_CONCAT(breezyTraceScope, __LINE__)(name)
+#define BREEZY_TRACE_ASYNC_BEGIN(name, cookie) KWin::BreezyTrace::asyncBegin(name, cookie)
+#define BREEZY_TRACE_ASYNC_END(name, cookie) KWin::BreezyTrace::asyncEnd(name, cookie)
+#define BREEZY_TRACE_COUNTER(name, value) KWin::BreezyTrace::counter(name, value)
+
+#else
+
+#define BREEZY_TRACE_SCOPE(name) do { } while (false)
+#define BREEZY_TRACE_ASYNC_BEGIN(name, cookie) do { } while (false)
+#define BREEZY_TRACE_ASYNC_END(name, cookie) do { } while (false)
+#define BREEZY_TRACE_COUNTER(name, value) do { } while (false)
+
+#endif
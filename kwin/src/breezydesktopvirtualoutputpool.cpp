@@ -0,0 +1,242 @@
+#include "breezydesktopvirtualoutputpool.h"
+
+#include "core/output.h"
+#include "core/outputconfiguration.h"
+#include "workspace.h"
+
+#include <kwin/main.h>
+#include <core/outputbackend.h>
+
+#include <QLoggingCategory>
+
+#include <algorithm>
+#include <utility>
+
+Q_DECLARE_LOGGING_CATEGORY(KWIN_XR)
+
+namespace KWin
+{
+
+QString BreezyDesktopVirtualOutputPool::add(QSize size, qreal scale, int textureUpdateRate)
+{
+    // parked displays are still wanted, revive() brings them back, so they're not up for reuse here
+    const int index = create(size, scale);
+    if (index < 0) return QString();
+    m_displays[index].textureUpdateRate = textureUpdateRate;
+    return m_displays[index].id;
+}
+
+int BreezyDesktopVirtualOutputPool::create(QSize size, qreal scale)
+{
+    ++m_createdCount;
+    const QString name = QStringLiteral("BreezyDesktop_%1").arg(m_createdCount);
+    #if defined(KWIN_VERSION_ENCODED) && KWIN_VERSION_ENCODED >= 60290
+        QString description = QStringLiteral("Breezy Display %1x%2 (%3)").arg(size.width()).arg(size.height()).arg(m_createdCount);
+        auto output = kwinApp()->outputBackend()->createVirtualOutput(name, description, size, scale);
+    #else
+        auto output = kwinApp()->outputBackend()->createVirtualOutput(name, size, scale);
+    #endif
+    ++m_reconfigurations;
+    if (!output) return -1;
+
+    Display display;
+    display.output = output;
+    display.id = name;
+    display.size = size;
+    m_displays.append(display);
+    return m_displays.size() - 1;
+}
+
+bool BreezyDesktopVirtualOutputPool::remove(const QString &id)
+{
+    auto it = std::find_if(m_displays.begin(), m_displays.end(), [&id](const Display &display) {
+        return display.id == id;
+    });
+    if (it == m_displays.end()) return false;
+
+    removeOutput(it->output);
+    m_displays.erase(it);
+    return true;
+}
+
+int BreezyDesktopVirtualOutputPool::park()
+{
+    QList<Display *> displays;
+    for (Display &display : m_displays) {
+        if (!display.parked) displays.append(&display);
+    }
+    if (displays.isEmpty()) return 0;
+
+    if (!setEnabled(displays, false)) {
+        // the backend wouldn't disable them, fall back to what disabling the effect used to do
+        qCWarning(KWIN_XR) << "\t\t\tBreezy - virtual outputs couldn't be parked, removing them";
+        for (Display *display : displays) {
+            removeOutput(display->output);
+            display->output = nullptr;
+        }
+        m_displays.removeIf([](const Display &display) { return !display.output; });
+    }
+    return displays.size();
+}
+
+int BreezyDesktopVirtualOutputPool::revive()
+{
+    QList<Display *> displays;
+    for (Display &display : m_displays) {
+        if (display.parked) displays.append(&display);
+    }
+    if (displays.isEmpty() || !setEnabled(displays, true)) return 0;
+    return displays.size();
+}
+
+bool BreezyDesktopVirtualOutputPool::restore(const QList<Placement> &placements)
+{
+    // Creating an output is a reconfiguration of its own that can't be batched, so reuse whatever fits first. New
+    // outputs are created before the configuration, which then places them along with the reused ones.
+    QList<int> assigned(placements.size(), -1);
+    QList<bool> used(m_displays.size(), false);
+    for (int i = 0; i < placements.size(); ++i) {
+        if (placements[i].id.isEmpty()) continue;
+        for (int j = 0; j < m_displays.size(); ++j) {
+            if (!used[j] && m_displays[j].id == placements[i].id && m_displays[j].size == placements[i].size) {
+                assigned[i] = j;
+                used[j] = true;
+                break;
+            }
+        }
+    }
+    for (int i = 0; i < placements.size(); ++i) {
+        if (assigned[i] >= 0) continue;
+        for (int j = 0; j < m_displays.size(); ++j) {
+            if (!used[j] && m_displays[j].size == placements[i].size) {
+                assigned[i] = j;
+                used[j] = true;
+                break;
+            }
+        }
+    }
+    bool complete = true;
+    for (int i = 0; i < placements.size(); ++i) {
+        if (assigned[i] >= 0) continue;
+        assigned[i] = create(placements[i].size, placements[i].scale);
+        if (assigned[i] < 0) complete = false;
+        else used.append(true);
+    }
+
+    // Whatever is left over isn't wanted anymore. It's disabled in the same configuration and only removed once that's
+    // applied, when it's no longer part of the layout. Parking it instead would let revive() bring it back and make
+    // every resize leave another output behind.
+    OutputConfiguration config;
+    for (int i = 0; i < placements.size(); ++i) {
+        if (assigned[i] < 0) continue;
+        auto changes = config.changeSet(m_displays[assigned[i]].output);
+        changes->enabled = true;
+        if (placements[i].position) changes->pos = *placements[i].position;
+        changes->scale = placements[i].scale;
+    }
+    for (int j = 0; j < m_displays.size(); ++j) {
+        if (!used[j]) config.changeSet(m_displays[j].output)->enabled = false;
+    }
+    workspace()->applyOutputConfiguration(config);
+    ++m_reconfigurations;
+
+    for (int i = 0; i < placements.size(); ++i) {
+        if (assigned[i] < 0) continue;
+        Display &display = m_displays[assigned[i]];
+        display.textureUpdateRate = placements[i].textureUpdateRate;
+        display.parked = false;
+        if (!display.output->isEnabled()) {
+            used[assigned[i]] = false;
+            complete = false;
+        }
+    }
+
+    for (int j = 0; j < m_displays.size(); ++j) {
+        if (used[j]) continue;
+        removeOutput(m_displays[j].output);
+        m_displays[j].output = nullptr;
+    }
+    m_displays.removeIf([](const Display &display) { return !display.output; });
+    return complete;
+}
+
+QList<BreezyDesktopVirtualOutputPool::Placement> BreezyDesktopVirtualOutputPool::placements() const
+{
+    QList<Placement> placements;
+    for (const Display &display : m_displays) {
+        if (display.parked) continue;
+        Placement placement;
+        placement.id = display.id;
+        placement.size = display.size;
+    #if defined(KWIN_VERSION_ENCODED) && KWIN_VERSION_ENCODED >= 60590
+        placement.position = display.output->position();
+    #else
+        placement.position = display.output->geometry().topLeft();
+    #endif
+        placement.scale = display.output->scale();
+        placement.textureUpdateRate = display.textureUpdateRate;
+        placements.append(placement);
+    }
+    return placements;
+}
+
+void BreezyDesktopVirtualOutputPool::clear()
+{
+    for (const Display &display : std::as_const(m_displays)) {
+        removeOutput(display.output);
+    }
+    m_displays.clear();
+}
+
+QList<BreezyDesktopVirtualOutputPool::Display> BreezyDesktopVirtualOutputPool::activeDisplays() const
+{
+    QList<Display> displays;
+    for (const Display &display : m_displays) {
+        if (!display.parked) displays.append(display);
+    }
+    return displays;
+}
+
+int BreezyDesktopVirtualOutputPool::parkedCount() const
+{
+    return std::count_if(m_displays.cbegin(), m_displays.cend(), [](const Display &display) {
+        return display.parked;
+    });
+}
+
+quint64 BreezyDesktopVirtualOutputPool::reconfigurations() const
+{
+    return m_reconfigurations;
+}
+
+bool BreezyDesktopVirtualOutputPool::setEnabled(const QList<Display *> &displays, bool enabled)
+{
+    // one configuration for all of them, so KWin only re-lays out the outputs and windows once
+    OutputConfiguration config;
+    for (Display *display : displays) {
+        config.changeSet(display->output)->enabled = enabled;
+    }
+    workspace()->applyOutputConfiguration(config);
+    ++m_reconfigurations;
+
+    // the result type of applyOutputConfiguration differs between KWin versions, the outputs' state doesn't
+    const bool applied = std::all_of(displays.cbegin(), displays.cend(), [enabled](const Display *display) {
+        return display->output->isEnabled() == enabled;
+    });
+    if (applied) {
+        for (Display *display : displays) {
+            display->parked = !enabled;
+        }
+    }
+    return applied;
+}
+
+void BreezyDesktopVirtualOutputPool::removeOutput(VirtualOutputHandle *output)
+{
+    if (!output) return;
+    // a disabled output isn't in the layout, so removing it doesn't re-lay out anything
+    if (output->isEnabled()) ++m_reconfigurations;
+    kwinApp()->outputBackend()->removeVirtualOutput(output);
+}
+
+} // namespace KWin
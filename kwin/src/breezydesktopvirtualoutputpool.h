@@ -0,0 +1,85 @@
+#pragma once
+
+#include <QList>
+#include <QPoint>
+#include <QSize>
+#include <QString>
+
+#include <optional>
+
+namespace KWin
+{
+    class BackendOutput;
+    class Output;
+
+#if defined(KWIN_VERSION_ENCODED) && KWIN_VERSION_ENCODED >= 60590
+    using VirtualOutputHandle = BackendOutput;
+#else
+    using VirtualOutputHandle = Output;
+#endif
+
+    // Owns the virtual outputs added through the DBus API. Creating or removing an output makes KWin rebuild its
+    // output layout and re-place every window, so when the effect is disabled they're parked (disabled, but still
+    // allocated) with a single output configuration change, and revived the same way when it's enabled again.
+    // Saved layouts are restored the same way: matching outputs are reused, and all positions, scales and enabled
+    // states are applied in one configuration. Only park() parks displays, so the pool never holds more outputs than
+    // the displays that were asked for.
+    class BreezyDesktopVirtualOutputPool
+    {
+    public:
+        struct Display {
+            VirtualOutputHandle *output = nullptr;
+            QString id;
+            QSize size;
+            int textureUpdateRate = 0; // Hz the effect updates the display's texture at, 0 for every frame
+            bool parked = false; // disabled by park() until revive()
+        };
+
+        // where a display sits in KWin's output layout, what layouts are saved as
+        struct Placement {
+            QString id; // optional, prefers the display with this id if it still has the same size
+            QSize size;
+            std::optional<QPoint> position; // left to KWin if unset
+            qreal scale = 1.0;
+            int textureUpdateRate = 0;
+        };
+
+        // creates a new display, returns its id or an empty string
+        QString add(QSize size, qreal scale = 1.0, int textureUpdateRate = 0);
+        bool remove(const QString &id);
+
+        // parks every active display or revives the parked ones, returns how many changed state
+        int park();
+        int revive();
+
+        // Makes the displays match the placements: reuses displays of the same size (parked or not), the one with the
+        // placement's id first, only creates outputs for the rest, and disables the displays that are left over in
+        // the same configuration before removing them. Returns false if some of them couldn't be created or enabled,
+        // those are removed too.
+        bool restore(const QList<Placement> &placements);
+
+        // the active displays' current placements
+        QList<Placement> placements() const;
+
+        // actually removes every display, parked or not
+        void clear();
+
+        // the displays that aren't parked
+        QList<Display> activeDisplays() const;
+        int parkedCount() const;
+
+        // output configuration changes (create, enable, disable or removing an enabled output) requested by the pool
+        quint64 reconfigurations() const;
+
+    private:
+        // appends the new display, returns its index or -1
+        int create(QSize size, qreal scale);
+        bool setEnabled(const QList<Display *> &displays, bool enabled);
+        void removeOutput(VirtualOutputHandle *output);
+
+        QList<Display> m_displays;
+        int m_createdCount = 0;
+        quint64 m_reconfigurations = 0;
+    };
+
+} // namespace KWin
@@ -0,0 +1,128 @@
+#include "breezydesktopwindowfiltermodel.h"
+
+#include "core/output.h"
+#include "effect/effecthandler.h"
+#include "window.h"
+
+namespace KWin
+{
+
+BreezyDesktopWindowFilterModel::BreezyDesktopWindowFilterModel(QObject *parent)
+    : QSortFilterProxyModel(parent)
+{
+    connect(effects, &EffectsHandler::desktopChanged, this, &BreezyDesktopWindowFilterModel::invalidateMembership);
+    connect(effects, &EffectsHandler::currentActivityChanged, this, &BreezyDesktopWindowFilterModel::invalidateMembership);
+}
+
+QObject *BreezyDesktopWindowFilterModel::screen() const
+{
+    return m_screen;
+}
+
+void BreezyDesktopWindowFilterModel::setScreen(QObject *screen)
+{
+    ScreenOutput *output = qobject_cast<ScreenOutput *>(screen);
+    if (m_screen == output) return;
+
+    if (m_screen) disconnect(m_screen, nullptr, this, nullptr);
+    m_screen = output;
+    m_screenGeometry = m_screen ? QRectF(m_screen->geometry()) : QRectF();
+    if (m_screen) {
+        connect(m_screen, &ScreenOutput::geometryChanged, this, [this]() {
+            m_screenGeometry = m_screen->geometry();
+            invalidateMembership();
+        });
+    }
+
+    invalidateMembership();
+    Q_EMIT screenChanged();
+}
+
+void BreezyDesktopWindowFilterModel::setSourceModel(QAbstractItemModel *model)
+{
+    if (sourceModel()) disconnect(sourceModel(), nullptr, this, nullptr);
+
+    m_accepted.clear();
+    QSortFilterProxyModel::setSourceModel(model);
+
+    m_windowRole = model ? model->roleNames().key(QByteArrayLiteral("window"), -1) : -1;
+    if (!model) return;
+
+    connect(model, &QAbstractItemModel::rowsInserted, this, [this](const QModelIndex &parent, int first, int last) {
+        if (!parent.isValid()) trackWindows(first, last);
+    });
+    connect(model, &QAbstractItemModel::rowsAboutToBeRemoved, this, [this](const QModelIndex &parent, int first, int last) {
+        if (parent.isValid()) return;
+        for (int row = first; row <= last; ++row) {
+            if (Window *window = windowAt(row)) {
+                disconnect(window, nullptr, this, nullptr);
+                m_accepted.remove(window);
+            }
+        }
+    });
+    connect(model, &QAbstractItemModel::modelReset, this, [this]() {
+        m_accepted.clear();
+        trackWindows(0, sourceModel()->rowCount() - 1);
+    });
+
+    trackWindows(0, model->rowCount() - 1);
+}
+
+Window *BreezyDesktopWindowFilterModel::windowAt(int sourceRow) const
+{
+    if (!sourceModel() || m_windowRole == -1) return nullptr;
+    return qobject_cast<Window *>(sourceModel()->index(sourceRow, 0).data(m_windowRole).value<QObject *>());
+}
+
+void BreezyDesktopWindowFilterModel::trackWindows(int first, int last)
+{
+    for (int row = first; row <= last; ++row) {
+        Window *window = windowAt(row);
+        if (!window) continue;
+
+        const auto changed = [this, window]() {
+            windowStateChanged(window);
+        };
+        connect(window, &Window::frameGeometryChanged, this, changed);
+        connect(window, &Window::minimizedChanged, this, changed);
+        connect(window, &Window::desktopsChanged, this, changed);
+        connect(window, &Window::activitiesChanged, this, changed);
+    }
+}
+
+bool BreezyDesktopWindowFilterModel::acceptsWindow(Window *window) const
+{
+    if (!window || !m_screen) return false;
+    if (window->isMinimized()) return false;
+    if (!window->isOnCurrentActivity() || !window->isOnCurrentDesktop()) return false;
+
+    // same overlap test as DesktopView.qml used to do per delegate: any amount of overlap counts
+    return window->frameGeometry().intersects(m_screenGeometry);
+}
+
+bool BreezyDesktopWindowFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+    if (sourceParent.isValid()) return false;
+
+    Window *window = windowAt(sourceRow);
+    const bool accepted = acceptsWindow(window);
+    if (window) {
+        if (accepted) m_accepted.insert(window);
+        else m_accepted.remove(window);
+    }
+    return accepted;
+}
+
+void BreezyDesktopWindowFilterModel::windowStateChanged(Window *window)
+{
+    // moves and resizes within the screen don't change membership, the delegates' bindings handle those
+    if (acceptsWindow(window) == m_accepted.contains(window)) return;
+    invalidateRowsFilter();
+}
+
+void BreezyDesktopWindowFilterModel::invalidateMembership()
+{
+    invalidateRowsFilter();
+}
+
+} // namespace KWin
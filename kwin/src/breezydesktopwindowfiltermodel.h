@@ -0,0 +1,51 @@
+#pragma once
+
+#include "breezydesktopeffect.h"
+
+#include <QPointer>
+#include <QSet>
+#include <QSortFilterProxyModel>
+
+namespace KWin
+{
+    class Window;
+
+    // Filters KWin's WindowModel down to the windows a single screen would show: overlapping the screen,
+    // on the current desktop and activity, and not minimized. Membership is re-evaluated per window when
+    // its geometry, desktops, activities or minimized state change, and the filter is only invalidated
+    // when a window actually enters or leaves the screen.
+    class BreezyDesktopWindowFilterModel : public QSortFilterProxyModel
+    {
+        Q_OBJECT
+        Q_PROPERTY(QObject *screen READ screen WRITE setScreen NOTIFY screenChanged)
+
+    public:
+        explicit BreezyDesktopWindowFilterModel(QObject *parent = nullptr);
+
+        QObject *screen() const;
+        void setScreen(QObject *screen);
+
+        void setSourceModel(QAbstractItemModel *sourceModel) override;
+
+    Q_SIGNALS:
+        void screenChanged();
+
+    protected:
+        bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+    private:
+        Window *windowAt(int sourceRow) const;
+        bool acceptsWindow(Window *window) const;
+        void trackWindows(int first, int last);
+        void windowStateChanged(Window *window);
+        void invalidateMembership();
+
+        QPointer<ScreenOutput> m_screen;
+        QRectF m_screenGeometry;
+        int m_windowRole = -1;
+
+        // windows currently passing the filter, so per-window changes can tell whether membership changed
+        mutable QSet<Window *> m_accepted;
+    };
+
+} // namespace KWin
@@ -155,6 +155,24 @@ void populateResolutionCombo(QComboBox *combo, const QStringList &custom)
     combo->setCurrentIndex(0);
 }
 
+void populateVirtualDisplayOptionCombos(QComboBox *scaleCombo, QComboBox *textureUpdateRateCombo)
+{
+    if (scaleCombo) {
+        scaleCombo->clear();
+        for (const qreal scale : {1.0, 1.25, 1.5, 2.0}) {
+            scaleCombo->addItem(QStringLiteral("%1%").arg(qRound(scale * 100)), scale);
+        }
+        scaleCombo->setCurrentIndex(0);
+    }
+    if (textureUpdateRateCombo) {
+        textureUpdateRateCombo->clear();
+        textureUpdateRateCombo->addItem(QObject::tr("Texture updates: every frame"), 0);
+        textureUpdateRateCombo->addItem(QObject::tr("Texture updates: 30 per second"), 30);
+        textureUpdateRateCombo->addItem(QObject::tr("Texture updates: 15 per second"), 15);
+        textureUpdateRateCombo->setCurrentIndex(0);
+    }
+}
+
 bool isCustomIndex(const QComboBox *combo, int index)
 {
     if (!combo || index < 0 || index >= combo->count()) return false;
@@ -267,6 +285,9 @@ BreezyDesktopEffectConfig::BreezyDesktopEffectConfig(QObject *parent, const KPlu
 
             auto removeBtn = widget()->findChild<QPushButton*>(QStringLiteral("buttonRemoveCustomResolution"));
             auto addBtn = widget()->findChild<QPushButton*>(QStringLiteral("buttonAddVirtualDisplay"));
+            auto scaleCombo = widget()->findChild<QComboBox*>(QStringLiteral("comboVirtualDisplayScale"));
+            auto textureUpdateRateCombo = widget()->findChild<QComboBox*>(QStringLiteral("comboVirtualDisplayTextureUpdateRate"));
+            populateVirtualDisplayOptionCombos(scaleCombo, textureUpdateRateCombo);
 
             combo->setProperty("lastResIndex", 0);
 
@@ -319,11 +340,13 @@ BreezyDesktopEffectConfig::BreezyDesktopEffectConfig(QObject *parent, const KPlu
 
 
             if (addBtn) {
-                connect(addBtn, &QPushButton::clicked, this, [this, combo]() {
+                connect(addBtn, &QPushButton::clicked, this, [this, combo, scaleCombo, textureUpdateRateCombo]() {
                     const int idx = combo->currentIndex();
                     const QSize sz = sizeForIndex(combo, idx);
                     if (sz.isValid()) {
-                        auto list = dbusAddVirtualDisplay(sz.width(), sz.height());
+                        const qreal scale = scaleCombo ? scaleCombo->currentData().toDouble() : 1.0;
+                        const int textureUpdateRate = textureUpdateRateCombo ? textureUpdateRateCombo->currentData().toInt() : 0;
+                        auto list = dbusAddVirtualDisplay(sz.width(), sz.height(), scale, textureUpdateRate);
                         renderVirtualDisplays(list);
                     }
                 });
@@ -675,11 +698,11 @@ QVariantList BreezyDesktopEffectConfig::dbusListVirtualDisplays() const {
     return reply.isValid() ? reply.value() : QVariantList{};
 }
 
-QVariantList BreezyDesktopEffectConfig::dbusAddVirtualDisplay(int w, int h) const {
+QVariantList BreezyDesktopEffectConfig::dbusAddVirtualDisplay(int w, int h, qreal scale, int textureUpdateRate) const {
     QDBusInterface iface = makeVDInterface();
     if (!iface.isValid()) return {};
     // Fire add, then fetch authoritative list to avoid marshalling quirks
-    iface.call(QStringLiteral("AddVirtualDisplay"), w, h);
+    iface.call(QStringLiteral("AddVirtualDisplayWithOptions"), w, h, scale, textureUpdateRate);
     QDBusReply<QVariantList> list = iface.call(QStringLiteral("ListVirtualDisplays"));
     return list.isValid() ? list.value() : QVariantList{};
 }
@@ -755,9 +778,11 @@ void BreezyDesktopEffectConfig::renderVirtualDisplays(const QVariantList &rows)
         const QString id = unwrapValue(row.value(QStringLiteral("id"))).toString();
         const int w = unwrapValue(row.value(QStringLiteral("width"))).toInt();
         const int h = unwrapValue(row.value(QStringLiteral("height"))).toInt();
+        const qreal scale = unwrapValue(row.value(QStringLiteral("scale"), 1.0)).toDouble();
+        const int textureUpdateRate = unwrapValue(row.value(QStringLiteral("textureUpdateRate"))).toInt();
 
         auto *rowWidget = new VirtualDisplayRow(listContainer);
-        rowWidget->setInfo(id, w, h);
+        rowWidget->setInfo(id, w, h, scale, textureUpdateRate);
         connect(rowWidget, &VirtualDisplayRow::removeRequested, this, [this](const QString &vid) {
             auto list = dbusRemoveVirtualDisplay(vid);
             renderVirtualDisplays(list);
@@ -64,7 +64,7 @@ private:
 
     // Virtual display DBus helpers and UI rendering
     QVariantList dbusListVirtualDisplays() const;
-    QVariantList dbusAddVirtualDisplay(int w, int h) const;
+    QVariantList dbusAddVirtualDisplay(int w, int h, qreal scale, int textureUpdateRate) const;
     QVariantList dbusRemoveVirtualDisplay(const QString &id) const;
     void renderVirtualDisplays(const QVariantList &rows);
 
@@ -20,8 +20,11 @@ VirtualDisplayRow::~VirtualDisplayRow() {
     delete ui;
 }
 
-void VirtualDisplayRow::setInfo(const QString &id, int w, int h) {
+void VirtualDisplayRow::setInfo(const QString &id, int w, int h, qreal scale, int textureUpdateRate) {
     m_id = id;
     ui->labelId->setText(id);
-    ui->labelRes->setText(QStringLiteral("%1x%2").arg(w).arg(h));
+    QString text = QStringLiteral("%1x%2").arg(w).arg(h);
+    if (!qFuzzyCompare(scale, 1.0)) text += QStringLiteral(" @ %1%").arg(qRound(scale * 100));
+    if (textureUpdateRate > 0) text += tr(", texture updates capped at %1 Hz").arg(textureUpdateRate);
+    ui->labelRes->setText(text);
 }
@@ -10,7 +10,7 @@ public:
     explicit VirtualDisplayRow(QWidget *parent = nullptr);
     ~VirtualDisplayRow() override;
 
-    void setInfo(const QString &id, int w, int h);
+    void setInfo(const QString &id, int w, int h, qreal scale = 1.0, int textureUpdateRate = 0);
 
 Q_SIGNALS:
     void removeRequested(const QString &id);
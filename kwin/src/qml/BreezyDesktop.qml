@@ -15,10 +15,25 @@ Node {
     property int lookingAtMonitorIndex: -1
     property var smoothFollowFocusedDisplay
 
+    // keeps the effect repainting while the head is still, see BreezyDesktopEffect::postPaintScreen
+    readonly property bool animationsActive: zoomOutAnimation.running || zoomInAnimation.running || zoomOnFocusSequence.running ||
+                                             smoothFollowTransitionAnimation.running || smoothFollowFocusedAnimation.running
+    onAnimationsActiveChanged: effect.animationsActive = animationsActive
+    Component.onDestruction: {
+        effect.animationsActive = false;
+        effect.instancedDisplaysActive = false;
+    }
+
     Displays {
         id: displays
     }
 
+    // flat displays can all share one rectangle, so they're drawn instanced from an atlas of the output textures
+    readonly property bool instancedDisplaysWanted: effect.instancedDisplays && effect.screenTextures !== null && !!fovDetails &&
+                                                    (!fovDetails.curvedDisplay || fovDetails.monitorWrappingScheme === 'flat')
+    readonly property bool instancedDisplaysActive: instancedDisplays.ready
+    onInstancedDisplaysActiveChanged: effect.instancedDisplaysActive = instancedDisplaysActive
+
     function displayAtIndex(index) {
         if (index < 0 || index >= screens.length) {
             return null;
@@ -164,10 +179,15 @@ Node {
             sizeAdjustedScreen: breezyDesktop.sizeAdjustedScreens[index]
             monitorPlacement: breezyDesktop.monitorPlacements[index]
             fovDetails: breezyDesktop.fovDetails
+            instanced: breezyDesktop.instancedDisplaysActive
+            // full LOD while looked at, and while still zoomed in on the way out
+            lodFocused: index === breezyDesktop.lookingAtMonitorIndex || zoomedIn
+            tessellationDistance: zoomedIn ? Math.min(targetDistance, effect.focusedDisplayDistance) : targetDistance
             
             property real smoothFollowTransitionProgress: 0.0
             property real monitorDistance: effect.allDisplaysDistance
             property real targetDistance: effect.allDisplaysDistance
+            readonly property bool zoomedIn: Math.abs(monitorDistance - effect.allDisplaysDistance) > 0.0001
             property real screenRotationY: displays.radianToDegree(monitorPlacement?.rotationAngleRadians.y ?? 0)
             property real screenRotationX: displays.radianToDegree(monitorPlacement?.rotationAngleRadians.x ?? 0)
             property matrix4x4 rotationMatrix: {
@@ -198,6 +218,14 @@ Node {
         }
     }
 
+    InstancedDisplays {
+        id: instancedDisplays
+        screens: breezyDesktop.screens
+        sizeAdjustedScreens: breezyDesktop.sizeAdjustedScreens
+        displayDelegates: breezyDesktopDisplays
+        wanted: breezyDesktop.instancedDisplaysWanted
+    }
+
     // smoothFollowEnabled gets cleared before the orientation begins slerping back to the origin so we can't just 
     // switch off smooth follow logic based on this flag. Instead, we have to rely on
     // smoothFollowTransitionProgress to determine how much of the orientations to apply.
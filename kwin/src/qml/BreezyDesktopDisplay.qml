@@ -1,5 +1,7 @@
 import QtQuick
 import QtQuick3D
+import org.kde.kwin as KWinComponents
+import org.kde.kwin.effect.breezy_desktop
 
 Model {
     id: display
@@ -14,26 +16,172 @@ Model {
     property size cursorImageSize: effect.cursorImageSize
     property point cursorPos: effect.cursorPos
 
+    // frustum culling: the effect decides from the latched pose, culled displays skip drawing and texture updates
+    readonly property bool culled: index < 31 && (effect.culledDisplayMask & (1 << index)) !== 0
+    property real boundsRadius: sizeAdjustedScreen ? Math.hypot(sizeAdjustedScreen.geometry.width, sizeAdjustedScreen.geometry.height) / 2 : -1
+    // drawn by InstancedDisplays.qml instead, the delegate only does placement
+    property bool instanced: false
+    visible: !culled && !instanced
+
+    function reportBounds() {
+        effect.setDisplayBounds(index, display.position, boundsRadius);
+    }
+
+    // tessellation metrics for developer mode, see BreezyDesktopEffect::setDisplayMeshStats
+    property bool reportMeshStats: false
+    function reportMesh() {
+        if (reportMeshStats) effect.setDisplayMeshStats(index, geometry.vertexCount, geometry.errorPixels);
+    }
+    onReportMeshStatsChanged: reportMesh()
+    Connections {
+        target: display.reportMeshStats ? display.geometry : null
+        function onVertexCountChanged() { display.reportMesh(); }
+        function onErrorPixelsChanged() { display.reportMesh(); }
+    }
+
+    onPositionChanged: reportBounds()
+    onBoundsRadiusChanged: reportBounds()
+    Component.onDestruction: {
+        effect.setDisplayBounds(index, Qt.vector3d(0, 0, 0), -1);
+        effect.setDisplayMeshStats(index, -1, 0);
+        effect.setDisplayPixelBudget(index, -1, 0, 0);
+    }
+
     Displays {
         id: displays
     }
 
+    // Focus LOD: set by BreezyDesktop.qml, stays true until the zoom out animation has finished so the
+    // resolution change happens while the display is out of focus
+    property bool lodFocused: true
+    readonly property bool lodReduced: effect.focusLodEnabled && !lodFocused
+    readonly property real focusTextureScale: lodReduced ? effect.unfocusedTextureScale : 1.0
+    readonly property real lodTextureScale: Math.min(focusTextureScale, distanceTextureScale)
+    readonly property bool lodMipmaps: effect.focusLodEnabled && lodFocused
+
+    // closest distance the display is shown at until the next change, so zoom animations don't re-tessellate every frame
+    property real tessellationDistance: effect.allDisplaysDistance
+
+    // Distance scaling: pixels the glasses can show per texture pixel at the closest distance, the texture isn't
+    // rendered at more detail than that. Rounded up to 5% steps so small distance changes don't reallocate it.
+    readonly property real screenDevicePixelRatio: screen.devicePixelRatio || 1.0
+    readonly property real visiblePixelRatio: fovDetails && sizeAdjustedScreen ?
+        displays.screenPixelScale(fovDetails, tessellationDistance) * sizeAdjustedScreen.geometry.width /
+            screen.geometry.width / screenDevicePixelRatio :
+        1.0
+    readonly property real distanceTextureScale: effect.distanceTextureScaling ?
+        Math.min(1.0, Math.max(0.25, Math.ceil(visiblePixelRatio * 20) / 20)) :
+        1.0
+
+    // pixel budget for developer mode, see BreezyDesktopEffect::setDisplayPixelBudget
+    property bool reportPixelBudget: effect.developerMode
+    function reportPixels() {
+        if (!reportPixelBudget) return;
+        const fullPixels = screen.geometry.width * screen.geometry.height * screenDevicePixelRatio * screenDevicePixelRatio;
+        effect.setDisplayPixelBudget(index, fullPixels, fullPixels * lodTextureScale * lodTextureScale,
+                                     fullPixels * Math.pow(Math.min(1.0, visiblePixelRatio), 2));
+    }
+    onReportPixelBudgetChanged: reportPixels()
+    onLodTextureScaleChanged: reportPixels()
+    onVisiblePixelRatioChanged: reportPixels()
+
+    // one damage-tracked texture per output, falls back to per-window thumbnails without OpenGL compositing
+    readonly property bool useOutputTexture: effect.displayTextureSource === 1 && effect.screenTextures !== null
+    property Item outputTexture: OutputTexture {
+        screen: display.screen
+        textureCache: display.useOutputTexture && !display.instanced ? effect.screenTextures : null
+        textureScale: display.lodTextureScale
+        mipmaps: display.lodMipmaps
+        visible: !display.culled
+        width: display.screen.geometry.width
+        height: display.screen.geometry.height
+    }
+    readonly property int workspaceScreenIndex: KWinComponents.Workspace.screens.indexOf(screen)
+
+    // The thumbnails' layer only re-renders when KWin reports damage on this screen (screenContentsDamaged),
+    // or for a moment after thumbnails were added, until their contents have arrived.
+    property Item desktopView: ShaderEffectSource {
+        live: effect.screenTextures === null || thumbnailsSettleTimer.running
+        hideSource: true
+        textureSize: Qt.size(width * display.lodTextureScale, height * display.lodTextureScale)
+        mipmap: display.lodMipmaps
+        visible: !display.culled
+        width: display.screen.geometry.width
+        height: display.screen.geometry.height
+        sourceItem: DesktopView {
+            screen: display.screen
+            active: !display.useOutputTexture
+            visible: !display.culled
+            width: display.screen.geometry.width
+            height: display.screen.geometry.height
+            onThumbnailsChanged: thumbnailsSettleTimer.restart()
+        }
+    }
+
+    Timer {
+        id: thumbnailsSettleTimer
+        interval: 500
+        running: true
+    }
+
+    // a virtual display's texture update cap in Hz, 0 to update on every damage. The output texture path applies it in
+    // BreezyDesktopScreenTextureCache, the thumbnails' layer holds damage back here.
+    readonly property int textureUpdateRate: effect.textureUpdateRates[screen.name] || 0
+    property real lastThumbnailsUpdate: 0
+
+    function updateThumbnails() {
+        lastThumbnailsUpdate = Date.now();
+        desktopView.scheduleUpdate();
+        effect.reportDisplayTextureUpdated();
+    }
+
+    Timer {
+        id: thumbnailsRateLimitTimer
+        onTriggered: display.updateThumbnails()
+    }
+
+    Connections {
+        target: effect
+        enabled: !display.useOutputTexture && !display.culled
+
+        function onScreenContentsDamaged(screenIndices) {
+            if (thumbnailsSettleTimer.running || !screenIndices.includes(display.workspaceScreenIndex)) return;
+            if (thumbnailsRateLimitTimer.running) return;
+
+            const wait = display.textureUpdateRate > 0 ?
+                1000 / display.textureUpdateRate - (Date.now() - display.lastThumbnailsUpdate) : 0;
+            if (wait > 0) {
+                thumbnailsRateLimitTimer.interval = Math.ceil(wait);
+                thumbnailsRateLimitTimer.start();
+                return;
+            }
+            display.updateThumbnails();
+        }
+    }
+
+    // damage isn't tracked while culled
+    onCulledChanged: if (!culled) desktopView.scheduleUpdate()
+
     // Default to simple rectangle source so we work on older Qt6
     // We'll attempt to dynamically load CurvableDisplayMesh.qml in onCompleted
     source: "#Rectangle"
 
     Component.onCompleted: {
+        reportBounds();
         try {
             const component = Qt.createComponent(Qt.resolvedUrl("CurvableDisplayMesh.qml"), Component.PreferSynchronous);
             if (component.status === Component.Ready) {
                 const mesh = component.createObject(display, {
                     fovDetails: Qt.binding(() => display.fovDetails),
                     monitorGeometry: Qt.binding(() => display.sizeAdjustedScreen ? display.sizeAdjustedScreen.geometry : null),
-                    fovConversionFns: Qt.binding(() => displays.fovConversionFns)
+                    fovConversionFns: Qt.binding(() => displays.fovConversionFns),
+                    displayDistance: Qt.binding(() => display.tessellationDistance),
+                    segmentScale: Qt.binding(() => display.focusTextureScale)
                 });
                 if (mesh) {
                     display.source = "";
                     display.geometry = mesh;
+                    display.reportMeshStats = Qt.binding(() => effect.developerMode);
                     effect.curvedDisplaySupported = true;
                 }
             } else {
@@ -59,13 +207,12 @@ Model {
             property real cursorH: display.cursorImageSize.height
             property bool showCursor: cursorX >= 0 && cursorX < screenWidth && cursorY >= 0 && cursorY < screenHeight
 
+            property bool desktopTexBottomUp: display.useOutputTexture
+
             property TextureInput desktopTex: TextureInput {
                 texture: Texture {
-                    sourceItem: DesktopView {
-                        screen: display.screen
-                        width: display.screen.geometry.width
-                        height: display.screen.geometry.height
-                    }
+                    sourceItem: display.useOutputTexture ? display.outputTexture : display.desktopView
+                    mipFilter: display.lodMipmaps ? Texture.Linear : Texture.None
                 }
             }
             property TextureInput cursorTex: TextureInput {
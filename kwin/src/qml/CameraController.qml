@@ -16,6 +16,7 @@ Item {
     property bool sbsEnabled: effect.sbsEnabled
     property bool customBannerEnabled: effect.customBannerEnabled
     property bool smoothFollowEnabled: effect.smoothFollowEnabled
+    property bool lateLatchPose: effect.lateLatchPose
     property real lookAheadScanlineMs: effect.lookAheadConfig[2]
     property var fovLengths: displays.diagonalToCrossFOVs(
         displays.degreeToRadian(effect.diagonalFOV),
@@ -60,11 +61,15 @@ Item {
                 effect.lookAheadOverride
             )
         );
+        updateCameraPosition(orientations[0], position);
+    }
+
+    function updateCameraPosition(orientation, position) {
         let lensVector = Qt.vector3d(0, 0, -fovDetails.lensDistancePixels);
 
         // if we only have 3DoF, account for a bit of positional change based on orientation,
         // don't do this for 6DoF to prevent doubling the positional movement due to rotation
-        if (!effect.poseHasPosition) lensVector = orientations[0].times(lensVector);
+        if (!effect.poseHasPosition) lensVector = orientation.times(lensVector);
 
         camera.position = position.times(fovDetails.fullScreenDistancePixels).plus(lensVector);
     }
@@ -151,16 +156,38 @@ Item {
         );
     }
 
-    Component.onCompleted: updateProjection();
+    function reportCameraDistances() {
+        effect.setCameraDistances(fovDetails.lensDistancePixels, fovDetails.fullScreenDistancePixels);
+    }
+
+    onFovDetailsChanged: reportCameraDistances()
+
+    Component.onCompleted: {
+        updateProjection();
+        reportCameraDistances();
+    }
+
+    // late-latch path: the effect computes the predicted pose right before the scene is rendered
+    Connections {
+        target: effect
+        enabled: cameraController.lateLatchPose
+        function onCameraPoseLatched() {
+            const rates = effect.cameraAngularRates;
+            camera.eulerRotation = effect.cameraEulerRotation;
+            updateCameraPosition(effect.cameraOrientation, effect.posePosition);
+            applyRollingShutterShear({ pitch: rates.x, yaw: rates.y });
+        }
+    }
 
     FrameAnimation {
-        running: true
+        running: !cameraController.lateLatchPose
         onTriggered: {
             const orientations = (effect.smoothFollowEnabled || smoothFollowDisabling) ? effect.smoothFollowOrigin : effect.poseOrientations;
             if (orientations && orientations.length > 0) {
                 const rates = ratesOfChange(orientations);
                 updateCamera(orientations, effect.posePosition, rates);
                 applyRollingShutterShear(rates);
+                effect.reportCameraPoseApplied(effect.poseTimestamp);
             }
         }
     }
@@ -0,0 +1,63 @@
+import QtQuick
+
+// Developer mode performance overlay, head-locked over the XR view. Reads BreezyDesktopEffect::hudStatistics, which
+// the effect only refreshes once a second, so the text is laid out once a second and not on every frame. Its rect is
+// reported to the effect so timewarp doesn't rotate it with the scene.
+Item {
+    id: developerHud
+
+    property var stats: effect.hudStatistics
+
+    function formatMs(value) {
+        return value === undefined ? "-" : value.toFixed(1) + " ms";
+    }
+
+    function formatLods(lods, focusedDisplay) {
+        if (!lods || lods.length === 0) return "-";
+        return lods.map(function(lod, index) {
+            const text = lod < 0 ? "-" : lod.toFixed(2);
+            return index === focusedDisplay ? `[${text}]` : text;
+        }).join(" ");
+    }
+
+    Component.onDestruction: effect.setHudRect(Qt.rect(0, 0, 0, 0))
+
+    Rectangle {
+        id: hudBackground
+
+        function reportRect() {
+            effect.setHudRect(visible ? mapToItem(null, 0, 0, width, height) : Qt.rect(0, 0, 0, 0));
+        }
+
+        onXChanged: reportRect()
+        onYChanged: reportRect()
+        onWidthChanged: reportRect()
+        onHeightChanged: reportRect()
+        onVisibleChanged: reportRect()
+
+        // kept off the edges, where the glasses' optics blur and clip
+        anchors.horizontalCenter: parent.horizontalCenter
+        anchors.top: parent.top
+        anchors.topMargin: parent.height * 0.2
+        width: hudText.implicitWidth + 24
+        height: hudText.implicitHeight + 16
+        radius: 6
+        color: "#b0000000"
+        visible: developerHud.stats.frames !== undefined
+
+        Text {
+            id: hudText
+            anchors.centerIn: parent
+            color: "#80ff80"
+            font.family: "monospace"
+            font.pixelSize: 18
+            text: [
+                `frame     ${developerHud.formatMs(developerHud.stats.frameTimeMs)} avg, ${developerHud.formatMs(developerHud.stats.frameTimeMaxMs)} max, ${developerHud.stats.frames} frames`,
+                `pose      ${(developerHud.stats.poseRateHz || 0).toFixed(0)} Hz, age ${developerHud.formatMs(developerHud.stats.poseAgeMs)}, ${(developerHud.stats.droppedSampleRateHz || 0).toFixed(0)}/s dropped`,
+                `lookahead ${developerHud.formatMs(developerHud.stats.lookAheadMs)}`,
+                `focused   ${developerHud.stats.focusedDisplay < 0 ? "none" : developerHud.stats.focusedDisplay}`,
+                `lod       ${developerHud.formatLods(developerHud.stats.displayLods, developerHud.stats.focusedDisplay)}`
+            ].join("\n")
+        }
+    }
+}
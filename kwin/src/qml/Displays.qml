@@ -116,8 +116,24 @@ QtObject {
         };
     }
 
-    // Utility constant
-    readonly property real segmentsPerRadian: 20.0 / degreeToRadian(90.0)
+    // Curved mesh tessellation: enough segments that no chord strays further than this from the true arc,
+    // measured in screen pixels at the distance the display is viewed from
+    readonly property real meshMaxErrorPixels: 1.0
+    readonly property int meshMinSegments: 1
+    readonly property int meshMaxSegments: 64
+
+    // screen pixels per display pixel for a display surface at displayDistance (same units as allDisplaysDistance)
+    function screenPixelScale(fovDetails, displayDistance) {
+        const lensToUnitDistancePixels = fovDetails.fullScreenDistancePixels - fovDetails.lensDistancePixels;
+        const lensToDisplayPixels = fovDetails.fullScreenDistancePixels * displayDistance - fovDetails.lensDistancePixels;
+        if (lensToDisplayPixels <= 0) return 1.0;
+        return lensToUnitDistancePixels / lensToDisplayPixels;
+    }
+
+    // projected sagitta: how far the middle of each chord sits from the arc it replaces, in screen pixels
+    function curvedSegmentErrorPixels(screenRadians, segments, radiusPixels, pixelScale) {
+        return radiusPixels * (1 - Math.cos(screenRadians / segments / 2)) * pixelScale;
+    }
 
     // FOV conversion functions for flat and curved displays
     property var fovConversionFns: ({
@@ -137,7 +153,7 @@ QtObject {
             fovRadiansAtDistance: function(fovRadians, unitLength, newScreenDistance) {
                 return 2 * Math.atan(unitLength / 2 / newScreenDistance);
             },
-            radiansToSegments: function(screenRadians) { return 1; }
+            radiansToSegments: function(screenRadians, radiusPixels, pixelScale) { return 1; }
         },
         curved: {
             centerToFovEdgeDistance: function(centerDistance, fovLength) {
@@ -155,12 +171,111 @@ QtObject {
             fovRadiansAtDistance: function(fovRadians, unitLength, newScreenDistance) {
                 return fovRadians / newScreenDistance;
             },
-            radiansToSegments: function(screenRadians) {
-                return Math.ceil(screenRadians * segmentsPerRadian);
+            radiansToSegments: function(screenRadians, radiusPixels, pixelScale) {
+                const maxSagittaPixels = meshMaxErrorPixels / pixelScale;
+                if (maxSagittaPixels >= radiusPixels) return meshMinSegments;
+
+                const segmentRadians = 2 * Math.acos(1 - maxSagittaPixels / radiusPixels);
+                return Math.min(meshMaxSegments, Math.max(meshMinSegments, Math.ceil(screenRadians / segmentRadians)));
             }
         }
     })
 
+    // Triangle strip for a display of monitorGeometry's size, centered on the origin and curved around the
+    // pivot point if curved displays are enabled for the wrapping direction.
+    // displayDistance is the closest the display gets to the viewer, in the same units as allDisplaysDistance.
+    // segmentScale < 1 thins out curved meshes, for displays that aren't looked at closely.
+    // Returns { positions: [vector3d], uvs: [vector2d], segments, errorPixels }, errorPixels being the largest
+    // projected deviation from the true curve.
+    function generateDisplayMesh(fovDetails, monitorGeometry, conversionFns, displayDistance = effect.allDisplaysDistance, segmentScale = 1.0) {
+        const fov = fovDetails;
+        const monitor = monitorGeometry;
+
+        const horizontalWrap = fov.monitorWrappingScheme === 'horizontal';
+        const horizontalConversions = horizontalWrap && fov.curvedDisplay ? conversionFns.curved : conversionFns.flat;
+
+        const sideEdgeDistancePixels = horizontalConversions.centerToFovEdgeDistance(
+            fov.completeScreenDistancePixels, fov.sizeAdjustedWidthPixels);
+        const horizontalRadians = horizontalConversions.lengthToRadians(
+            fov.defaultDistanceHorizontalRadians,
+            fov.widthPixels,
+            sideEdgeDistancePixels,
+            monitor.width
+        );
+
+        const verticalWrap = fov.monitorWrappingScheme === 'vertical';
+        const verticalConversions = verticalWrap && fov.curvedDisplay ? conversionFns.curved : conversionFns.flat;
+        const topEdgeDistancePixels = verticalConversions.centerToFovEdgeDistance(
+            fov.completeScreenDistancePixels, fov.sizeAdjustedHeightPixels);
+        const verticalRadians = verticalConversions.lengthToRadians(
+            fov.defaultDistanceVerticalRadians,
+            fov.heightPixels,
+            topEdgeDistancePixels,
+            monitor.height
+        );
+
+        const positions = [];
+        const uvs = [];
+
+        const radius = fov.completeScreenDistancePixels;
+        function vertexFor(s, t) {
+            let z = 0;
+
+            const xOffset = s - 0.5;
+            let x = xOffset * monitor.width;
+            if (fov.curvedDisplay && horizontalWrap) {
+                const xOffsetRadians = xOffset * horizontalRadians;
+                x = Math.sin(xOffsetRadians) * radius;
+                z = radius - Math.cos(xOffsetRadians) * radius;
+            }
+
+            const yOffset = t - 0.5;
+            let y = yOffset * monitor.height;
+            if (fov.curvedDisplay && verticalWrap) {
+                const yOffsetRadians = yOffset * verticalRadians;
+                y = Math.sin(yOffsetRadians) * radius;
+                z = radius - Math.cos(yOffsetRadians) * radius;
+            }
+
+            return { pos: Qt.vector3d(x, y, z), uv: Qt.vector2d(s, t) };
+        }
+
+        const pixelScale = screenPixelScale(fov, displayDistance);
+        let segments = 1;
+        let wrapRadians = 0;
+        if (horizontalWrap) {
+            segments = horizontalConversions.radiansToSegments(horizontalRadians, radius, pixelScale);
+            wrapRadians = horizontalRadians;
+        }
+        if (verticalWrap) {
+            segments = verticalConversions.radiansToSegments(verticalRadians, radius, pixelScale);
+            wrapRadians = verticalRadians;
+        }
+        segments = Math.max(meshMinSegments, Math.ceil(segments * segmentScale));
+        const errorPixels = fov.curvedDisplay && (horizontalWrap || verticalWrap) ?
+            curvedSegmentErrorPixels(wrapRadians, segments, radius, pixelScale) : 0;
+
+        for (let i = 0; i <= segments; i++) {
+            const texFraction = i / segments;
+
+            // !verticalWrap also covers "flat" wrap scheme
+            const texX0 = !verticalWrap ? texFraction : 0;
+            const texX1 = !verticalWrap ? texFraction : 1;
+
+            const texY0 = verticalWrap ? texFraction : 1;
+            const texY1 = verticalWrap ? texFraction : 0;
+
+            let vtxB = vertexFor(texX0, texY0);
+            let vtxT = vertexFor(texX1, texY1);
+            positions.push(vtxB.pos);
+            positions.push(vtxT.pos);
+            uvs.push(vtxB.uv);
+            uvs.push(vtxT.uv);
+        }
+
+        return { positions: positions, uvs: uvs, segments: segments, errorPixels: errorPixels };
+    }
+
     function monitorWrap(cachedMonitorRadians, monitorSpacingPixels, monitorBeginPixel, monitorLengthPixels, lengthToRadianFn) {
         var closestWrapPixel = monitorBeginPixel;
         var closestWrap = cachedMonitorRadians[monitorBeginPixel];
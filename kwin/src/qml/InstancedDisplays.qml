@@ -0,0 +1,124 @@
+import QtQuick
+import QtQuick3D
+import org.kde.kwin.effect.breezy_desktop
+
+// All flat displays in a single instanced draw call: one shared rectangle, an instance per display delegate carrying
+// its transform, and the display's slot in the output texture atlas as instance data. The delegates still handle
+// placement, focus and animations, they just stop drawing themselves once this is ready.
+Model {
+    id: instancedDisplays
+
+    required property var screens
+    required property var sizeAdjustedScreens
+    required property Repeater3D displayDelegates
+
+    // acquire the atlas while true, draw once it's been laid out for every screen
+    property bool wanted: false
+    readonly property bool ready: wanted && atlas.atlasRects.length === screens.length && atlas.atlasRects.length > 0 &&
+                                  atlas.atlasRects.every(rect => rect.width > 0)
+    visible: ready
+
+    property Item atlas: OutputTexture {
+        atlasScreens: instancedDisplays.wanted ? instancedDisplays.screens : []
+        textureCache: instancedDisplays.wanted ? effect.screenTextures : null
+        width: 1
+        height: 1
+    }
+
+    // the display under the cursor and the cursor's rect in that display's top-down texture coordinates
+    readonly property int cursorDisplayIndex: screens.findIndex(screen => {
+        const geometry = screen.geometry;
+        return effect.cursorPos.x >= geometry.x && effect.cursorPos.x < geometry.x + geometry.width &&
+               effect.cursorPos.y >= geometry.y && effect.cursorPos.y < geometry.y + geometry.height;
+    })
+    readonly property vector4d cursorRect: {
+        if (cursorDisplayIndex === -1) return Qt.vector4d(0, 0, 0, 0);
+
+        const geometry = screens[cursorDisplayIndex].geometry;
+        return Qt.vector4d((effect.cursorPos.x - geometry.x) / geometry.width, (effect.cursorPos.y - geometry.y) / geometry.height,
+                           effect.cursorImageSize.width / geometry.width, effect.cursorImageSize.height / geometry.height);
+    }
+
+    source: "#Rectangle"
+    instancing: InstanceList {
+        id: instanceList
+    }
+
+    Component {
+        id: instanceEntry
+        InstanceListEntry {}
+    }
+
+    function rebuildInstances() {
+        // copied, the list property reads back live
+        const oldEntries = [];
+        for (let i = 0; i < instanceList.instances.length; i++) {
+            oldEntries.push(instanceList.instances[i]);
+        }
+        const entries = [];
+        for (let i = 0; i < screens.length; i++) {
+            const display = displayDelegates.objectAt(i);
+            if (!display) continue;
+
+            const index = i;
+            entries.push(instanceEntry.createObject(instancedDisplays, {
+                position: Qt.binding(() => display.position),
+                rotation: Qt.binding(() => display.rotation),
+
+                // default rectangle is 100x100; culled displays collapse to nothing instead of leaving the instance list
+                scale: Qt.binding(() => {
+                    const geometry = instancedDisplays.sizeAdjustedScreens[index]?.geometry;
+                    if (!geometry || display.culled) return Qt.vector3d(0, 0, 0);
+                    return Qt.vector3d(geometry.width / 100, geometry.height / 100, 1);
+                }),
+
+                // the display index for the cursor check, 8 bits is plenty
+                color: Qt.rgba(index / 255, 0, 0, 1),
+                customData: Qt.binding(() => {
+                    const rect = instancedDisplays.atlas.atlasRects[index];
+                    return rect ? Qt.vector4d(rect.x, rect.y, rect.width, rect.height) : Qt.vector4d(0, 0, 0, 0);
+                })
+            }));
+        }
+        instanceList.instances = entries;
+        for (let i = 0; i < oldEntries.length; i++) {
+            oldEntries[i].destroy();
+        }
+    }
+
+    Connections {
+        target: instancedDisplays.displayDelegates
+        function onObjectAdded() { instancedDisplays.rebuildInstances(); }
+        function onObjectRemoved() { instancedDisplays.rebuildInstances(); }
+    }
+    onScreensChanged: rebuildInstances()
+    Component.onCompleted: rebuildInstances()
+
+    materials: [
+        CustomMaterial {
+            depthDrawMode: CustomMaterial.AlwaysDepthDraw
+            shadingMode: CustomMaterial.Unshaded
+
+            property int cursorDisplayIndex: instancedDisplays.cursorDisplayIndex
+            property vector4d cursorRect: instancedDisplays.cursorRect
+
+            property TextureInput atlasTex: TextureInput {
+                texture: Texture {
+                    sourceItem: instancedDisplays.atlas
+                }
+            }
+            property TextureInput cursorTex: TextureInput {
+                texture: Texture {
+                    sourceItem: Image {
+                        source: effect.cursorImageSource
+                        width: effect.cursorImageSize.width
+                        height: effect.cursorImageSize.height
+                    }
+                }
+            }
+
+            fragmentShader: "instancedDisplay.frag"
+            vertexShader: "instancedDisplay.vert"
+        }
+    ]
+}
@@ -0,0 +1,110 @@
+import QtQuick
+import org.kde.kwin as KWinComponents
+
+// Scene description for the native OpenGL render backend: computes the same placements and meshes as
+// BreezyDesktop.qml and hands them to the effect, which does the drawing. Zoom on focus and smooth follow
+// animations aren't supported on this path, displays stay at the all-displays distance.
+Item {
+    id: nativeDisplays
+
+    required property var screens
+    required property var sizeAdjustedScreens
+    required property var fovDetails
+    required property var monitorPlacements
+
+    property int lookingAtMonitorIndex: -1
+    property int reportedBoundsCount: 0
+
+    Displays {
+        id: displays
+    }
+
+    function displayModelMatrix(monitorPlacement) {
+        const matrix = Qt.matrix4x4();
+        const rotationMatrix = Qt.matrix4x4();
+        rotationMatrix.rotate(displays.radianToDegree(monitorPlacement.rotationAngleRadians.y), Qt.vector3d(0, 1, 0));
+        rotationMatrix.rotate(displays.radianToDegree(monitorPlacement.rotationAngleRadians.x), Qt.vector3d(1, 0, 0));
+
+        // same as BreezyDesktop.displayRotationVector with monitorDistance at the all-displays distance
+        const position = rotationMatrix.times(displays.nwuToEusVector(monitorPlacement.centerNoRotate));
+        matrix.translate(position);
+        return matrix.times(rotationMatrix);
+    }
+
+    function buildScene() {
+        if (!fovDetails || !monitorPlacements || monitorPlacements.length !== screens.length) return null;
+
+        const sceneDisplays = [];
+        for (let i = 0; i < screens.length; i++) {
+            const mesh = displays.generateDisplayMesh(fovDetails, sizeAdjustedScreens[i].geometry, displays.fovConversionFns);
+            const vertices = [];
+            for (let v = 0; v < mesh.positions.length; v++) {
+                const position = mesh.positions[v];
+                const uv = mesh.uvs[v];
+                vertices.push(position.x, position.y, position.z, uv.x, uv.y);
+            }
+
+            const model = displayModelMatrix(monitorPlacements[i]);
+            sceneDisplays.push({
+                screenIndex: KWinComponents.Workspace.screens.indexOf(screens[i]),
+                model: model,
+                vertices: vertices
+            });
+
+            const geometry = sizeAdjustedScreens[i].geometry;
+            effect.setDisplayBounds(i, model.times(Qt.vector3d(0, 0, 0)), Math.hypot(geometry.width, geometry.height) / 2);
+            if (effect.developerMode) effect.setDisplayMeshStats(i, mesh.positions.length, mesh.errorPixels);
+        }
+
+        // drop bounds of displays that went away
+        for (let i = screens.length; i < reportedBoundsCount; i++) {
+            effect.setDisplayBounds(i, Qt.vector3d(0, 0, 0), -1);
+            effect.setDisplayMeshStats(i, -1, 0);
+        }
+        reportedBoundsCount = screens.length;
+
+        return {
+            displays: sceneDisplays,
+            lensDistancePixels: fovDetails.lensDistancePixels,
+            fullScreenDistancePixels: fovDetails.fullScreenDistancePixels
+        };
+    }
+
+    function pushScene() {
+        const scene = buildScene();
+        if (scene) effect.setNativeScene(scene);
+    }
+
+    onScreensChanged: pushScene()
+    onSizeAdjustedScreensChanged: pushScene()
+    onFovDetailsChanged: pushScene()
+    onMonitorPlacementsChanged: pushScene()
+    Component.onCompleted: pushScene()
+
+    // focus tracking for the effect (cursor to focused display, smooth follow settings), same cadence as BreezyDesktop.qml
+    Timer {
+        interval: 500
+        repeat: true
+        running: true
+        onTriggered: {
+            const orientations = effect.smoothFollowEnabled ? effect.smoothFollowOrigin : effect.poseOrientations;
+            if (!orientations || orientations.length === 0) return;
+
+            const posePosition = effect.posePosition.times(nativeDisplays.fovDetails.fullScreenDistancePixels);
+            const lookingAtIndex = displays.findFocusedMonitor(
+                displays.eusToNwuQuat(orientations[0]),
+                displays.eusToNwuVector(posePosition),
+                nativeDisplays.monitorPlacements.map(monitorVectors => monitorVectors.centerLook),
+                nativeDisplays.lookingAtMonitorIndex,
+                effect.smoothFollowEnabled,
+                nativeDisplays.fovDetails,
+                nativeDisplays.sizeAdjustedScreens.map(screen => screen.geometry)
+            );
+
+            if (nativeDisplays.lookingAtMonitorIndex !== lookingAtIndex) {
+                nativeDisplays.lookingAtMonitorIndex = lookingAtIndex;
+                effect.lookingAtScreenIndex = lookingAtIndex;
+            }
+        }
+    }
+}
@@ -13,7 +13,8 @@ Item {
     }
 
     Image {
-        source: effect.customBannerEnabled ? "custom_banner.png" : "calibrating.png"
+        // next to the installed QML, which may not be where this file was loaded from
+        source: effect.assetsUrl + (effect.customBannerEnabled ? "custom_banner.png" : "calibrating.png")
         visible: supportsXR && showCalibratingBanner
         anchors.horizontalCenter: desktopViewComponent.horizontalCenter
         anchors.bottom: desktopViewComponent.bottom
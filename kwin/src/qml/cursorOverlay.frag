@@ -3,7 +3,9 @@ VARYING vec2 texcoord;
 
 void MAIN() {
     vec2 tex = vec2(texcoord.x, 1.0 - texcoord.y);
-    vec4 color = texture(desktopTex, tex);
+
+    // output textures come straight from KWin, which renders bottom-up
+    vec4 color = texture(desktopTex, desktopTexBottomUp ? texcoord : tex);
     if (showCursor) {
         vec2 fragCoord = tex * vec2(screenWidth, screenHeight);
         vec2 cursorTopLeft = vec2(cursorX, cursorY);
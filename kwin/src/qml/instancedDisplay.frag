@@ -0,0 +1,18 @@
+VARYING vec2 texcoord;
+VARYING vec4 atlasRect;
+VARYING float displayIndex;
+
+void MAIN() {
+    // the atlas is bottom-up like the output textures it's copied from
+    vec4 color = texture(atlasTex, atlasRect.xy + texcoord * atlasRect.zw);
+    if (int(displayIndex + 0.5) == cursorDisplayIndex) {
+        vec2 tex = vec2(texcoord.x, 1.0 - texcoord.y);
+        vec2 cursorTopLeft = cursorRect.xy;
+        vec2 cursorBottomRight = cursorRect.xy + cursorRect.zw;
+        if (tex.x >= cursorTopLeft.x && tex.x < cursorBottomRight.x && tex.y >= cursorTopLeft.y && tex.y < cursorBottomRight.y) {
+            vec4 cursorCol = texture(cursorTex, (tex - cursorTopLeft) / cursorRect.zw);
+            color = mix(color, cursorCol, cursorCol.a);
+        }
+    }
+    FRAGCOLOR = color;
+}
@@ -0,0 +1,11 @@
+VARYING vec2 texcoord;
+VARYING vec4 atlasRect;
+VARYING float displayIndex;
+
+void MAIN()
+{
+    texcoord = UV0;
+    atlasRect = INSTANCE_DATA;
+    displayIndex = INSTANCE_COLOR.r * 255.0;
+    POSITION = INSTANCE_MODELVIEWPROJECTION_MATRIX * vec4(VERTEX, 1.0);
+}
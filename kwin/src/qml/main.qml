@@ -132,12 +132,16 @@ Item {
     Component {
         id: view3DComponent
         View3D {
-            anchors.fill: parent
+            // rendered at renderScale and scaled back up to the full size, the auto quality mode lowers it on slow GPUs
+            width: parent.width * root.effect.renderScale
+            height: parent.height * root.effect.renderScale
+            scale: 1.0 / root.effect.renderScale
+            transformOrigin: Item.TopLeft
             environment: SceneEnvironment {
-                antialiasingMode: root.effect.antialiasingQuality === 0 ? SceneEnvironment.NoAA : SceneEnvironment.SSAA
-                antialiasingQuality: root.effect.antialiasingQuality === 0 ? SceneEnvironment.Medium : (
-                    root.effect.antialiasingQuality === 1 ? SceneEnvironment.Medium : (
-                    root.effect.antialiasingQuality === 2 ? SceneEnvironment.High : SceneEnvironment.VeryHigh))
+                antialiasingMode: root.effect.effectiveAntialiasingQuality === 0 ? SceneEnvironment.NoAA : SceneEnvironment.SSAA
+                antialiasingQuality: root.effect.effectiveAntialiasingQuality === 0 ? SceneEnvironment.Medium : (
+                    root.effect.effectiveAntialiasingQuality === 1 ? SceneEnvironment.Medium : (
+                    root.effect.effectiveAntialiasingQuality === 2 ? SceneEnvironment.High : SceneEnvironment.VeryHigh))
             }
             
             CustomCamera { 
@@ -161,15 +165,48 @@ Item {
         }
     }
 
+    Component {
+        id: nativeDisplaysComponent
+        NativeDisplays {
+            anchors.fill: parent
+            screens: root.screens
+            sizeAdjustedScreens: root.sizeAdjustedScreens
+            fovDetails: root.fovDetails
+            monitorPlacements: root.monitorPlacements
+        }
+    }
+
+    // The XR scene stays loaded through pose resets (recenter, calibration) and is only hidden, so it comes back on the
+    // next frame instead of rebuilding its meshes, materials and textures. The flat desktop with the banner covers for it.
+    Loader {
+        id: xrLoader
+        anchors.fill: parent
+        visible: !root.poseResetState
+    }
+
+    Loader {
+        id: desktopLoader
+        anchors.fill: parent
+    }
+
+    // drawn by the Qt Quick scene, so not while the native backend paints the displays
     Loader {
-        id: viewLoader
         anchors.fill: parent
+        active: root.developerMode && xrLoader.item !== null && root.effect.renderBackend !== 1
+        visible: xrLoader.visible
+        sourceComponent: DeveloperHud {}
     }
 
     function checkLoadedComponent() {
         console.log(`Breezy - checking screen ${targetScreen.model}: ${targetScreenSupported} ${targetScreenIsVirtual} ${isEnabled} ${poseResetState}`);
-        const show3DView = targetScreenSupported && isEnabled && !poseResetState;
-        if (!targetScreenIsVirtual) viewLoader.sourceComponent = show3DView ? view3DComponent : desktopViewComponent;
+        const keepXRView = targetScreenSupported && isEnabled;
+        const show3DView = keepXRView && !poseResetState;
+        const xrComponent = root.effect.renderBackend === 1 ? nativeDisplaysComponent : view3DComponent;
+        if (!targetScreenIsVirtual) {
+            // Loader ignores re-assigning the current component, so a warm scene isn't touched here
+            xrLoader.sourceComponent = keepXRView ? xrComponent : null;
+            desktopLoader.sourceComponent = show3DView ? null : desktopViewComponent;
+        }
         if (targetScreenSupported) effect.effectTargetScreenIndex = KWinComponents.Workspace.screens.indexOf(targetScreen);
     }
 
@@ -184,6 +221,13 @@ Item {
     onIsEnabledChanged: {
         checkLoadedComponent();
     }
+
+    Connections {
+        target: root.effect
+        function onRenderBackendChanged() {
+            checkLoadedComponent();
+        }
+    }
     
     Component.onCompleted: {
         checkLoadedComponent();
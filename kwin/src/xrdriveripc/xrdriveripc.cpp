@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <cmath>
+#include <QElapsedTimer>
 #include <QFileInfo>
 #include <QProcess>
 #include <QProcessEnvironment>
@@ -36,9 +37,26 @@ std::string XRDriverIPC::configHome() const {
 	return configHome.toStdString();
 }
 
+void XRDriverIPC::setCallObserver(CallObserver observer) {
+	std::lock_guard<std::mutex> lock(m_callObserverMutex);
+	m_callObserver = std::move(observer);
+}
+
 QByteArray XRDriverIPC::invokePython(const QString &method,
 										   const QByteArray &payloadJson,
 										   const QString &singleArg) const {
+	QElapsedTimer timer;
+	timer.start();
+	QByteArray out = runPython(method, payloadJson, singleArg);
+	const double durationMs = timer.nsecsElapsed() / 1e6;
+	std::lock_guard<std::mutex> lock(m_callObserverMutex);
+	if (m_callObserver) m_callObserver(method, durationMs, !out.isEmpty());
+	return out;
+}
+
+QByteArray XRDriverIPC::runPython(const QString &method,
+										const QByteArray &payloadJson,
+										const QString &singleArg) const {
 	QProcess proc;
 	QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
 	env.insert(QStringLiteral("BREEZY_METHOD"), method);
@@ -4,6 +4,8 @@
 #include <QString>
 #include <QByteArray>
 #include <QJsonObject>
+#include <functional>
+#include <mutex>
 #include <optional>
 
 // Export header generated by CMake (GenerateExportHeader)
@@ -87,6 +89,12 @@ public:
 	bool verifyToken(const std::string &token);
 	bool resetDriver();
 
+	// Called after every driver call, on the calling thread, with the python method, how long it took and whether
+	// it produced output. Safe to set or clear while calls are running on other threads: once setCallObserver returns,
+	// the previous observer is no longer being called.
+	using CallObserver = std::function<void(const QString &method, double durationMs, bool succeeded)>;
+	void setCallObserver(CallObserver observer);
+
 
 private:
 	XRDriverIPC() = default;
@@ -98,7 +106,12 @@ private:
 	QByteArray invokePython(const QString &method,
 							const QByteArray &payloadJson,
 							const QString &singleArg) const;
+	QByteArray runPython(const QString &method,
+						 const QByteArray &payloadJson,
+						 const QString &singleArg) const;
 
 	bool m_initialized = false;
 	QString m_pythonDir; // directory containing xrdriveripc.py
+	mutable std::mutex m_callObserverMutex; // held while the observer is called, so clearing it waits for a running call
+	CallObserver m_callObserver;
 };